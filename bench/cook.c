@@ -0,0 +1,198 @@
+/* Micro benchmarks for the containers and allocators of cook.h.
+ *
+ * Build and run it with `./nob bench-cook`.
+ */
+#include <stdio.h>
+#include <time.h>
+
+#define COOK_IMPLEMENTATION
+#define COOK_STRIP_PREFIX
+#include "../cook.h"
+
+#define ARGLIST_ITERATIONS (1000*1000*4)
+#define PUSH_COUNT         (1000*1000*16)
+
+static volatile size_t sink; /* keeps the optimizer from dropping the work */
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec*1e9 + (double)ts.tv_nsec;
+}
+
+static void report(const char *name, double elapsed_ns, size_t ops)
+{
+    printf("%-32s %10.2f ms %8.2f ns/op\n", name, elapsed_ns/1e6, elapsed_ns/(double)ops);
+}
+
+/* per-call argument lists: a fresh list of 0..8 items for every call */
+
+static void bench_arglist_vec(void)
+{
+    double start = now_ns();
+    for (size_t i = 0; i < ARGLIST_ITERATIONS; i++) {
+        void **args = NULL;
+        for (size_t k = 0; k < i % 9; k++) vec_push(args, (void*)k);
+        sink += vec_size(args);
+        vec_free(args);
+    }
+    report("arglist/cook_vec", now_ns() - start, ARGLIST_ITERATIONS);
+}
+
+static void bench_arglist_svec(void)
+{
+    double start = now_ns();
+    for (size_t i = 0; i < ARGLIST_ITERATIONS; i++) {
+        Small_Vector(void*, 8) args;
+        svec_init(&args);
+        for (size_t k = 0; k < i % 9; k++) svec_push(&args, (void*)k);
+        sink += svec_size(&args);
+        svec_free(&args);
+    }
+    report("arglist/cook_svec(8)", now_ns() - start, ARGLIST_ITERATIONS);
+}
+
+static void bench_arglist_arena(void)
+{
+    double start = now_ns();
+    for (size_t i = 0; i < ARGLIST_ITERATIONS; i++) {
+        temp_scope(1) {
+            void **args = NULL;
+            for (size_t k = 0; k < i % 9; k++) vec_push_arena(temp_arena(), args, (void*)k);
+            sink += vec_size(args);
+        }
+    }
+    report("arglist/cook_vec_push_arena", now_ns() - start, ARGLIST_ITERATIONS);
+}
+
+/* one long vector built by pushing */
+
+static void bench_push_vec(void)
+{
+    double start = now_ns();
+    int *xs = NULL;
+    for (int i = 0; i < PUSH_COUNT; i++) vec_push(xs, i);
+    sink += vec_size(xs);
+    vec_free(xs);
+    report("push/cook_vec", now_ns() - start, PUSH_COUNT);
+}
+
+static void bench_push_vec_reserved(void)
+{
+    double start = now_ns();
+    int *xs = NULL;
+    vec_reserve(xs, PUSH_COUNT);
+    for (int i = 0; i < PUSH_COUNT; i++) vec_push(xs, i);
+    sink += vec_size(xs);
+    vec_free(xs);
+    report("push/cook_vec+reserve", now_ns() - start, PUSH_COUNT);
+}
+
+static void bench_push_arena(void)
+{
+    size_t capacity = sizeof(Cook_Vector_Header) + 2*PUSH_COUNT*sizeof(int);
+    void *buffer = malloc(capacity);
+    Arena arena = arena_from_buffer(buffer, capacity);
+
+    double start = now_ns();
+    int *xs = NULL;
+    for (int i = 0; i < PUSH_COUNT; i++) vec_push_arena(&arena, xs, i);
+    sink += vec_size(xs);
+    report("push/cook_vec_push_arena", now_ns() - start, PUSH_COUNT);
+
+    free(buffer);
+}
+
+static void bench_push_svec(void)
+{
+    double start = now_ns();
+    Small_Vector(int, 8) xs = {0};
+    for (int i = 0; i < PUSH_COUNT; i++) svec_push(&xs, i);
+    sink += svec_size(&xs);
+    svec_free(&xs);
+    report("push/cook_svec(8)", now_ns() - start, PUSH_COUNT);
+}
+
+static void bench_sb_append(void)
+{
+    double start = now_ns();
+    String_Builder sb = NULL;
+    for (int i = 0; i < PUSH_COUNT/4; i++) sb_append(&sb, "DrawText %d\n", i);
+    sink += vec_size(sb);
+    sb_free(&sb);
+    report("push/cook_sb_append", now_ns() - start, PUSH_COUNT/4);
+}
+
+/* fixed-size objects churned through a working set */
+
+#define CHURN_OBJECT_SIZE 96 /* about an ffi_cif plus a small argument frame */
+#define CHURN_LIVE        256
+
+static void bench_churn_malloc(void)
+{
+    void *live[CHURN_LIVE] = {0};
+    double start = now_ns();
+    for (size_t i = 0; i < PUSH_COUNT; i++) {
+        size_t k = (i*7919) % CHURN_LIVE;
+        free(live[k]);
+        live[k] = malloc(CHURN_OBJECT_SIZE);
+        *(size_t*)live[k] = i;
+    }
+    report("churn/malloc", now_ns() - start, PUSH_COUNT);
+    arr_foreach(void*, live, it) free(*it);
+}
+
+static void bench_churn_pool(void)
+{
+    void *live[CHURN_LIVE] = {0};
+    Pool pool;
+    pool_init(&pool, CHURN_OBJECT_SIZE);
+    double start = now_ns();
+    for (size_t i = 0; i < PUSH_COUNT; i++) {
+        size_t k = (i*7919) % CHURN_LIVE;
+        pool_free(&pool, live[k]);
+        live[k] = pool_alloc(&pool);
+        *(size_t*)live[k] = i;
+    }
+    report("churn/cook_pool", now_ns() - start, PUSH_COUNT);
+    Pool_Stats stats = pool_stats(&pool);
+    printf("    %zu slabs, %zu/%zu live (peak %zu), %.1f%% occupied\n",
+           stats.slab_count, stats.live, stats.capacity, stats.peak, 100.0*stats.occupancy);
+    pool_destroy(&pool);
+}
+
+static void bench_churn_pool_cache(void)
+{
+    void *live[CHURN_LIVE] = {0};
+    Pool pool;
+    Pool_Cache cache;
+    pool_init(&pool, CHURN_OBJECT_SIZE);
+    pool_cache_init(&cache, &pool);
+    double start = now_ns();
+    for (size_t i = 0; i < PUSH_COUNT; i++) {
+        size_t k = (i*7919) % CHURN_LIVE;
+        pool_cache_free(&cache, live[k]);
+        live[k] = pool_cache_alloc(&cache);
+        *(size_t*)live[k] = i;
+    }
+    report("churn/cook_pool_cache", now_ns() - start, PUSH_COUNT);
+    pool_cache_flush(&cache);
+    pool_destroy(&pool);
+}
+
+int main(void)
+{
+    bench_arglist_vec();
+    bench_arglist_svec();
+    bench_arglist_arena();
+    bench_push_vec();
+    bench_push_vec_reserved();
+    bench_push_arena();
+    bench_push_svec();
+    bench_sb_append();
+    bench_churn_malloc();
+    bench_churn_pool();
+    bench_churn_pool_cache();
+    return 0;
+}
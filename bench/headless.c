@@ -0,0 +1,80 @@
+/* A headless stand-in for libraylib.so.
+ *
+ * The window and drawing calls scripts make, with the prototypes of
+ * raylib.h, doing no more than folding their arguments into a checksum.
+ * `./nob pgo` builds it as build/libheadless.so and replays scripts against
+ * it with `./main -l build/libheadless.so`, so the timing and the profile
+ * cover lexing and dispatch rather than the GPU driver.
+ */
+#include <stdio.h>
+
+#include "../raylib/include/raylib.h"
+
+static unsigned long long checksum = 0xcbf29ce484222325ull;
+static int frames;
+
+static void mix(unsigned long long x)
+{
+    checksum = (checksum ^ x)*0x100000001b3ull;
+}
+
+static void mix_color(Color color)
+{
+    mix((unsigned) color.r | (unsigned) color.g << 8 | (unsigned) color.b << 16 | (unsigned) color.a << 24);
+}
+
+static void mix_text(const char *text)
+{
+    while (*text) mix((unsigned char) *text++);
+}
+
+void InitWindow(int width, int height, const char *title)
+{
+    mix((unsigned) width << 16 | (unsigned) height);
+    mix_text(title);
+}
+
+void CloseWindow(void)
+{
+    fprintf(stderr, "headless: %d frames, checksum %016llx\n", frames, checksum);
+}
+
+void SetTargetFPS(int fps)                  { mix((unsigned) fps); }
+void SetWindowTitle(const char *title)      { mix_text(title); }
+void SetWindowSize(int width, int height)   { mix((unsigned) width << 16 | (unsigned) height); }
+void BeginDrawing(void)                     { mix(1); }
+void EndDrawing(void)                       { frames++; }
+void ClearBackground(Color color)           { mix_color(color); }
+
+void DrawPixel(int posX, int posY, Color color)
+{
+    mix((unsigned) posX << 16 | (unsigned) posY);
+    mix_color(color);
+}
+
+void DrawLine(int startPosX, int startPosY, int endPosX, int endPosY, Color color)
+{
+    mix((unsigned) startPosX << 16 | (unsigned) startPosY);
+    mix((unsigned) endPosX << 16 | (unsigned) endPosY);
+    mix_color(color);
+}
+
+void DrawRectangle(int posX, int posY, int width, int height, Color color)
+{
+    mix((unsigned) posX << 16 | (unsigned) posY);
+    mix((unsigned) width << 16 | (unsigned) height);
+    mix_color(color);
+}
+
+void DrawRectangleLines(int posX, int posY, int width, int height, Color color)
+{
+    DrawRectangle(posX, posY, width, height, color);
+}
+
+void DrawText(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    mix_text(text);
+    mix((unsigned) posX << 16 | (unsigned) posY);
+    mix((unsigned) fontSize);
+    mix_color(color);
+}
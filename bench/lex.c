@@ -0,0 +1,270 @@
+/* Throughput of stb_c_lexer.h over a multi-megabyte input.
+ *
+ *     bench_lex [-r rounds] [-p cpu] [-n corpus] [-o results.jsonl] [files...]
+ *
+ * The input is the given files (or a few headers of this repository)
+ * repeated until it reaches INPUT_SIZE. It is lexed in place and streamed
+ * through a read buffer of CHUNK_SIZE bytes, the way a pipe or socket front
+ * end would feed it, `rounds` times each, optionally pinned to one cpu.
+ * Every mode prints a line, and appends a JSON object to results.jsonl
+ * with -o. Build and run every variant over every corpus with
+ * `./nob bench-lex`.
+ */
+#define _GNU_SOURCE           /* sched_setaffinity() */
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define STB_C_LEXER_IMPLEMENTATION
+#include "../stb_c_lexer.h"
+
+#define COOK_IMPLEMENTATION
+#define COOK_STRIP_PREFIX
+#include "../cook.h"
+
+#define INPUT_SIZE (1024*1024*8)
+#define ROUNDS     5          /* by default */
+#define MAX_ROUNDS 64
+#define CHUNK_SIZE (1024*64)
+#define MAX_ATOMS  (1024*64)
+#define MAX_LINES  (1024*64) /* fewer than the input has, so the index thins out */
+
+#ifndef VARIANT
+#define VARIANT "default"
+#endif
+
+static const char *default_files[] = {
+    "raylib/include/raylib.h",
+    "raylib/include/rlgl.h",
+    "stb_c_lexer.h",
+    "nob.h",
+    "cook.h",
+};
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec*1e9 + (double)ts.tv_nsec;
+}
+
+typedef struct {
+    const char *corpus;
+    int rounds;
+    int cpu;                  /* -1 if not pinned */
+    FILE *json;
+} Options;
+
+static int compare_doubles(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/* prints the best of the rounds and appends all of them, in order, to the JSON results */
+static void report(const Options *opt, const char *mode, size_t size, const double *elapsed, size_t tokens, size_t checksum)
+{
+    double sorted[MAX_ROUNDS];
+    memcpy(sorted, elapsed, opt->rounds*sizeof(*elapsed));
+    qsort(sorted, (size_t)opt->rounds, sizeof(*sorted), compare_doubles);
+    double best = sorted[0], median = sorted[opt->rounds/2];
+
+    printf("%-8s %-8s %-6s %8.2f MB in %7.2f ms (median %7.2f) %8.1f MB/s %7.2f Mtok/s  (%zu tokens, checksum %zx)\n",
+           VARIANT, opt->corpus, mode, size/1e6, best/1e6, median/1e6, size/(best/1e9)/1e6, tokens/(best/1e9)/1e6, tokens, checksum);
+    if (!opt->json) return;
+
+    fprintf(opt->json, "{\"variant\": \"%s\", \"corpus\": \"%s\", \"mode\": \"%s\", \"cpu\": %d, "
+            "\"bytes\": %zu, \"tokens\": %zu, \"checksum\": \"%zx\", \"best_ms\": %.3f, \"median_ms\": %.3f, "
+            "\"mb_per_s\": %.1f, \"mtok_per_s\": %.2f, \"rounds_ms\": [",
+            VARIANT, opt->corpus, mode, opt->cpu, size, tokens, checksum, best/1e6, median/1e6,
+            size/(best/1e9)/1e6, tokens/(best/1e9)/1e6);
+    for (int i = 0; i < opt->rounds; i++) fprintf(opt->json, "%s%.3f", i ? ", " : "", elapsed[i]/1e6);
+    fprintf(opt->json, "]}\n");
+}
+
+static bool pin_to_cpu(int cpu)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+static bool read_file(const char *path, String_Builder *sb)
+{
+    File_Map map;
+    if (!file_map(&map, path, COOK_FILE_MAP_SEQUENTIAL)) {
+        fprintf(stderr, "ERROR: could not open %s\n", path);
+        return false;
+    }
+    sb_append_parts(sb, map.data, map.count);
+    file_unmap(&map);
+    return true;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [-r rounds] [-p cpu] [-n corpus] [-o results.jsonl] [files...]\n", program);
+}
+
+int main(int argc, char **argv)
+{
+    String_Builder file = NULL;
+    String_Builder input = NULL;
+    Options opt = {"headers", ROUNDS, -1, NULL};
+    const char *json_path = NULL;
+    int i = 1;
+
+    for (; i < argc && argv[i][0] == '-'; i++) {
+        if (i + 1 == argc || argv[i][1] == '\0' || argv[i][2] != '\0') {
+            usage(argv[0]);
+            return 1;
+        }
+        switch (argv[i][1]) {
+        case 'r': opt.rounds = atoi(argv[++i]); break;
+        case 'p': opt.cpu = atoi(argv[++i]); break;
+        case 'n': opt.corpus = argv[++i]; break;
+        case 'o': json_path = argv[++i]; break;
+        default:
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if (opt.rounds < 1 || opt.rounds > MAX_ROUNDS) {
+        fprintf(stderr, "ERROR: rounds must be between 1 and %d\n", MAX_ROUNDS);
+        return 1;
+    }
+    if (opt.cpu >= 0 && !pin_to_cpu(opt.cpu)) {
+        fprintf(stderr, "WARNING: could not pin to cpu %d, running unpinned\n", opt.cpu);
+        opt.cpu = -1;
+    }
+    if (json_path && !(opt.json = fopen(json_path, "a"))) {
+        fprintf(stderr, "ERROR: could not open %s\n", json_path);
+        return 1;
+    }
+
+    int first_file = i;
+    for (; i < argc; i++) if (!read_file(argv[i], &file)) return 1;
+    if (first_file == argc) arr_foreach(const char*, default_files, path) if (!read_file(*path, &file)) return 1;
+    if (vec_empty(file)) return 1;
+
+    while (vec_size(input) < INPUT_SIZE) {
+        sb_append_parts(&input, file, vec_size(file));
+        sb_append_parts(&input, "\n", 1);
+    }
+
+    size_t size = vec_size(input);
+    char *storage = malloc(size + 1);
+    double elapsed[MAX_ROUNDS];
+    size_t tokens = 0, checksum = 0;
+
+#ifdef LEX_ATOMS
+    char *atom_memory = malloc(STB_C_LEX_ATOMS_MEMORY(MAX_ATOMS, MAX_ATOMS*16));
+    stb_lex_atoms atoms;
+#endif
+#ifdef LEX_LINES
+    /* every token gets located, like a run that warns about everything */
+    static int line_memory[MAX_LINES];
+    stb_lex_lines lines;
+    stb_lex_location loc;
+    size_t line_sum = 0;
+#endif
+
+    for (int round = 0; round < opt.rounds; round++) {
+        stb_lexer lex;
+        stb_c_lexer_init(&lex, input, input + size, storage, (int)size + 1);
+#ifdef LEX_ATOMS
+        stb_c_lexer_atoms_init(&atoms, atom_memory, STB_C_LEX_ATOMS_MEMORY(MAX_ATOMS, MAX_ATOMS*16), MAX_ATOMS);
+        stb_c_lexer_set_atoms(&lex, &atoms);
+#endif
+#ifdef LEX_LINES
+        stb_c_lexer_lines_init(&lines, line_memory, MAX_LINES);
+        stb_c_lexer_set_lines(&lex, &lines);
+        line_sum = 0;
+#endif
+
+        tokens = 0;
+        checksum = 0;
+        double start = now_ns();
+        while (stb_c_lexer_get_token(&lex)) {
+            tokens++;
+            checksum += (size_t)lex.token + (size_t)(lex.where_lastchar - lex.where_firstchar);
+#ifdef LEX_LINES
+            stb_c_lexer_get_location(&lex, lex.where_firstchar, &loc);
+            line_sum += (size_t)loc.line_number;
+#endif
+        }
+        elapsed[round] = now_ns() - start;
+    }
+
+    report(&opt, "whole", size, elapsed, tokens, checksum);
+#ifdef LEX_LINES
+    printf("%-8s %-8s whole  line sum %zx\n", VARIANT, opt.corpus, line_sum);
+    {
+        stb_lexer plain;
+        stb_c_lexer_init(&plain, input, input + size, storage, (int)size + 1);
+        double start = now_ns();
+        stb_c_lexer_get_location(&plain, input + size - 1, &loc);
+        printf("%-8s %-8s one location without the index: %.2f ms (line %d)\n", VARIANT, opt.corpus, (now_ns() - start)/1e6, loc.line_number);
+    }
+#endif
+
+    static char chunk[CHUNK_SIZE];
+    char carry[1024*4];
+    for (int round = 0; round < opt.rounds; round++) {
+        stb_lex_stream stream;
+        stb_c_lexer_stream_init(&stream, carry, sizeof(carry), storage, (int)size + 1);
+#ifdef LEX_ATOMS
+        stb_c_lexer_atoms_init(&atoms, atom_memory, STB_C_LEX_ATOMS_MEMORY(MAX_ATOMS, MAX_ATOMS*16), MAX_ATOMS);
+        stb_c_lexer_set_atoms(&stream.lexer, &atoms);
+#endif
+#ifdef LEX_LINES
+        stb_c_lexer_lines_init(&lines, line_memory, MAX_LINES);
+        stb_c_lexer_set_lines(&stream.lexer, &lines);
+        line_sum = 0;
+#endif
+
+        tokens = 0;
+        checksum = 0;
+        size_t offset = 0;
+        double start = now_ns();
+        for (;;) {
+            if (stb_c_lexer_stream_get_token(&stream)) {
+                tokens++;
+                checksum += (size_t)stream.lexer.token + (size_t)(stream.lexer.where_lastchar - stream.lexer.where_firstchar);
+#ifdef LEX_LINES
+                stb_c_lexer_stream_get_location(&stream, stream.lexer.where_firstchar, &loc);
+                line_sum += (size_t)loc.line_number;
+#endif
+                continue;
+            }
+            if (stream.lexer.token == CLEX_eof) break;
+            if (offset == size) {
+                stb_c_lexer_stream_finish(&stream);
+                continue;
+            }
+            size_t n = size - offset < CHUNK_SIZE ? size - offset : CHUNK_SIZE;
+            memcpy(chunk, input + offset, n); /* stands in for read() */
+            offset += n;
+            stb_c_lexer_stream_feed(&stream, chunk, chunk + n);
+        }
+        elapsed[round] = now_ns() - start;
+    }
+
+    report(&opt, "stream", size, elapsed, tokens, checksum);
+#ifdef LEX_LINES
+    printf("%-8s %-8s stream line sum %zx\n", VARIANT, opt.corpus, line_sum);
+#endif
+
+#ifdef LEX_ATOMS
+    printf("%-8s %-8s %zu distinct identifiers\n", VARIANT, opt.corpus, (size_t)atoms.count);
+    free(atom_memory);
+#endif
+    if (opt.json) fclose(opt.json);
+    free(storage);
+    vec_free(input);
+    vec_free(file);
+    return 0;
+}
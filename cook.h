@@ -1,12 +1,13 @@
 /*
-cook.h - v0.05 - Dylaris 2025
+cook.h - v0.12 - Dylaris 2025
 ===================================================
 
 BRIEF:
   Pieces of C implemented using C99.
 
 NOTICE:
-  Not compatible with C++.
+  Written in C99, but also compiles as C++. See cook.hpp for typed
+  C++ containers that share memory layout with the ones here.
 
 USAGE:
   In exactly one source file, define the implementation macro
@@ -17,7 +18,17 @@ USAGE:
   ```
   In other files, just include the header without the macro.
 
+  The temporary allocator is thread-local by default. Define
+  COOK_TEMP_SINGLE_THREADED before including this header (in every
+  file) to get the plain static buffer back.
+
 HISTORY:
+    v0.12 Support 'file map'
+    v0.11 Compile as C++, add cook.hpp
+    v0.10 Support 'pool allocator' with per-thread caches
+    v0.09 Support 'small vector', arena-backed and reserve/shrink for 'dynamic array'
+    v0.08 Grow 'string builder' geometrically
+    v0.07 Support 'arena allocator', make 'temp allocator' thread-local
     v0.06 Support 'temp allocator', 'string view', 'string builder'
     v0.05 Remove 'list', 'deque', 'string', 'file'
     v0.04 Support data-structure 'mini hash table'
@@ -41,6 +52,14 @@ LICENSE:
 
 #define COOK_ASSERT(x) assert(x)
 
+#ifdef __cplusplus
+    #include <type_traits>
+    #define COOK_DECLTYPE_CAST(T) (std::remove_reference<decltype(T)>::type)
+    extern "C" {
+#else
+    #define COOK_DECLTYPE_CAST(T)
+#endif
+
 /*
  * dynamic array
  */
@@ -52,23 +71,23 @@ typedef struct Cook_Vector_Header {
 #define cook_vec_header(vec) ((Cook_Vector_Header*)((char*)(vec) - sizeof(Cook_Vector_Header)))
 #define cook_vec_size(vec) ((vec) ? cook_vec_header(vec)->size : 0)
 #define cook_vec_capacity(vec) ((vec) ? cook_vec_header(vec)->capacity : 0)
-#define cook_vec_push(vec, item)                                        \
-    do {                                                                \
-        if (cook_vec_size(vec) + 1 > cook_vec_capacity(vec)) {          \
-            size_t new_capacity = cook_vec_capacity(vec) < 16           \
-                            ? 16 : 2 * cook_vec_capacity(vec);          \
-            (vec) = cook_vec_resize(vec, new_capacity, sizeof(*(vec))); \
-        }                                                               \
-        (vec)[cook_vec_header(vec)->size++] = (item);                   \
+#define cook_vec_push(vec, item)                                                               \
+    do {                                                                                       \
+        if (cook_vec_size(vec) + 1 > cook_vec_capacity(vec)) {                                 \
+            size_t new_capacity = cook_vec_grow_capacity(                                      \
+                cook_vec_capacity(vec), cook_vec_size(vec) + 1);                               \
+            (vec) = COOK_DECLTYPE_CAST(vec)cook_vec_resize(vec, new_capacity, sizeof(*(vec))); \
+        }                                                                                      \
+        (vec)[cook_vec_header(vec)->size++] = (item);                                          \
     } while (0)
 #define cook_vec_pop(vec) ((vec)[--cook_vec_header(vec)->size])
 #define cook_vec_empty(vec) (cook_vec_size(vec) == 0)
 #define cook_vec_full(vec) (cook_vec_size(vec) == cook_vec_capacity(vec))
 #define cook_vec_end(vec) ((vec) + cook_vec_size(vec))
-#define cook_vec_grow(vec, cap)                                \
-    do {                                                       \
-        size_t new_cap = cook_vec_capacity(vec) + (cap);       \
-        (vec) = cook_vec_resize((vec), new_cap, sizeof(*vec)); \
+#define cook_vec_grow(vec, cap)                                                       \
+    do {                                                                              \
+        size_t new_cap = cook_vec_capacity(vec) + (cap);                              \
+        (vec) = COOK_DECLTYPE_CAST(vec)cook_vec_resize((vec), new_cap, sizeof(*vec)); \
     } while (0)
 #define cook_vec_free(vec)                   \
     do {                                     \
@@ -79,8 +98,112 @@ typedef struct Cook_Vector_Header {
     do {                                         \
         if (vec) cook_vec_header(vec)->size = 0; \
     } while (0)
+#define cook_vec_reserve(vec, n)                                                                 \
+    do {                                                                                         \
+        if ((n) > cook_vec_capacity(vec)) {                                                      \
+            size_t new_capacity = cook_vec_grow_capacity(cook_vec_capacity(vec),                 \
+                                                         (n));                                   \
+            (vec) = COOK_DECLTYPE_CAST(vec)cook_vec_resize((vec), new_capacity, sizeof(*(vec))); \
+        }                                                                                        \
+    } while (0)
+#define cook_vec_shrink(vec)                                                                           \
+    do {                                                                                               \
+        if (cook_vec_empty(vec)) {                                                                     \
+            cook_vec_free(vec);                                                                        \
+        } else if (cook_vec_size(vec) < cook_vec_capacity(vec)) {                                      \
+            (vec) = COOK_DECLTYPE_CAST(vec)cook_vec_resize((vec), cook_vec_size(vec), sizeof(*(vec))); \
+        }                                                                                              \
+    } while (0)
 #define cook_vec_foreach(type, vec, iter) for (type *iter = (vec); iter < cook_vec_end(vec); iter++)
 void *cook_vec_resize(void *vec, size_t new_capacity, size_t item_size);
+size_t cook_vec_grow_capacity(size_t capacity, size_t needed);
+
+/*
+ * The same vector, but every allocation comes from an arena. Such a vector is
+ * released together with the arena; never cook_vec_free() or cook_vec_shrink()
+ * it. Growing the most recent allocation of the arena happens in place.
+ */
+#define cook_vec_push_arena(arena, vec, item)                                                                   \
+    do {                                                                                                        \
+        if (cook_vec_size(vec) + 1 > cook_vec_capacity(vec)) {                                                  \
+            size_t new_capacity = cook_vec_grow_capacity(                                                       \
+                cook_vec_capacity(vec), cook_vec_size(vec) + 1);                                                \
+            (vec) = COOK_DECLTYPE_CAST(vec)cook_vec_resize_arena((arena), (vec), new_capacity, sizeof(*(vec))); \
+        }                                                                                                       \
+        (vec)[cook_vec_header(vec)->size++] = (item);                                                           \
+    } while (0)
+#define cook_vec_reserve_arena(arena, vec, n)                                                                   \
+    do {                                                                                                        \
+        if ((n) > cook_vec_capacity(vec)) {                                                                     \
+            size_t new_capacity = cook_vec_grow_capacity(cook_vec_capacity(vec), (n));                          \
+            (vec) = COOK_DECLTYPE_CAST(vec)cook_vec_resize_arena((arena), (vec), new_capacity, sizeof(*(vec))); \
+        }                                                                                                       \
+    } while (0)
+struct Cook_Arena;
+void *cook_vec_resize_arena(struct Cook_Arena *arena, void *vec, size_t new_capacity, size_t item_size);
+
+
+/*
+ * small vector
+ *
+ * A vector that keeps its first N items inline (on the stack, or inside the
+ * struct that owns it) and only spills to the heap when it outgrows them.
+ * Zero-initialize it with `= {0}`, or with cook_svec_init() in hot loops,
+ * which leaves the inline storage untouched.
+ * ```
+ *   Cook_Small_Vector(ffi_type*, 8) atypes = {0};
+ *   cook_svec_push(&atypes, &ffi_type_sint32);
+ *   ffi_prep_cif(&cif, abi, cook_svec_size(&atypes), rtype, cook_svec_data(&atypes));
+ *   cook_svec_free(&atypes);
+ * ```
+ */
+#define Cook_Small_Vector(type, n) \
+    struct { size_t size; size_t capacity; type *heap; type inline_items[n]; }
+
+#define cook_svec_init(sv) ((sv)->size = 0, (sv)->capacity = 0, (sv)->heap = NULL)
+#define cook_svec_data(sv) ((sv)->heap ? (sv)->heap : (sv)->inline_items)
+#define cook_svec_size(sv) ((sv)->size)
+#define cook_svec_capacity(sv) ((sv)->heap ? (sv)->capacity : cook_arr_size((sv)->inline_items))
+#define cook_svec_inline(sv) ((sv)->heap == NULL)
+#define cook_svec_empty(sv) ((sv)->size == 0)
+#define cook_svec_end(sv) (cook_svec_data(sv) + (sv)->size)
+#define cook_svec_reserve(sv, n)                                                                                  \
+    do {                                                                                                          \
+        if ((n) > cook_svec_capacity(sv)) {                                                                       \
+            (sv)->heap = COOK_DECLTYPE_CAST((sv)->heap)cook_svec_grow((sv)->heap, (sv)->inline_items, (sv)->size, \
+                                        &(sv)->capacity,                                                          \
+                                        cook_arr_size((sv)->inline_items), (n),                                   \
+                                        sizeof(*(sv)->inline_items));                                             \
+        }                                                                                                         \
+    } while (0)
+#define cook_svec_push(sv, item)                                         \
+    do {                                                                 \
+        if ((sv)->size + 1 > cook_svec_capacity(sv)) {                   \
+            cook_svec_reserve((sv), (sv)->size + 1);                     \
+        }                                                                \
+        cook_svec_data(sv)[(sv)->size++] = (item);                       \
+    } while (0)
+#define cook_svec_pop(sv) (cook_svec_data(sv)[--(sv)->size])
+#define cook_svec_reset(sv) ((sv)->size = 0)
+#define cook_svec_shrink(sv)                                                           \
+    do {                                                                               \
+        if ((sv)->heap && (sv)->size <= cook_arr_size((sv)->inline_items)) {           \
+            memcpy((sv)->inline_items, (sv)->heap, (sv)->size*sizeof(*(sv)->heap));    \
+            free((sv)->heap);                                                          \
+            (sv)->heap = NULL;                                                         \
+            (sv)->capacity = 0;                                                        \
+        }                                                                              \
+    } while (0)
+#define cook_svec_free(sv)     \
+    do {                       \
+        free((sv)->heap);      \
+        (sv)->heap = NULL;     \
+        (sv)->capacity = 0;    \
+        (sv)->size = 0;        \
+    } while (0)
+#define cook_svec_foreach(type, sv, iter) for (type *iter = cook_svec_data(sv); iter < cook_svec_end(sv); iter++)
+void *cook_svec_grow(void *heap, const void *inline_items, size_t size, size_t *capacity,
+                     size_t inline_capacity, size_t needed, size_t item_size);
 
 
 /*
@@ -141,6 +264,28 @@ void cook_hash_free(Cook_Mini_Hash *lookup);
     #define cook_dll_geterr() dlerror()
 #endif
 
+/*
+ * file map
+ *
+ * A read-only view of a whole file. A regular file is mapped, so nothing is
+ * copied and pages come in as they are touched; what can't be mapped, like a
+ * pipe or a terminal, is read into the heap instead. The hints only advise
+ * the kernel about a mapping and are ignored for a file that was read.
+ */
+#define COOK_FILE_MAP_SEQUENTIAL 0x1 /* read ahead aggressively, drop pages behind */
+#define COOK_FILE_MAP_WILLNEED   0x2 /* start reading the whole file in now */
+#define COOK_FILE_MAP_HUGE_PAGES 0x4 /* MADV_HUGEPAGE, if the filesystem can back it */
+
+typedef struct Cook_File_Map {
+    const char *data;         /* "" for an empty file, never NULL */
+    size_t count;
+    bool mapped;              /* false if it was read */
+} Cook_File_Map;
+
+/* the same shape as nob_file_map() of nob.h */
+bool cook_file_map(Cook_File_Map *map, const char *path, unsigned hints);
+void cook_file_unmap(Cook_File_Map *map);
+
 /*
  * memory layout
  */
@@ -177,30 +322,70 @@ Cook_String_View cook_sv_rtrim(Cook_String_View sv);
 
 /*
  * string builder
+ *
+ * Capacity grows geometrically, so n appends cost O(n) amortized. Formatted
+ * appends are written straight into the free tail of the buffer.
  */
 typedef char *Cook_String_Builder; /* vector of char */
 
+void cook_sb_reserve(Cook_String_Builder *sb, size_t extra); /* room for 'extra' more bytes */
 void cook_sb_append_sv(Cook_String_Builder *sb, Cook_String_View sv);
 void cook_sb_append_parts(Cook_String_Builder *sb, const char *data, size_t length);
+void cook_sb_append(Cook_String_Builder *sb, const char *fmt, ...);
+void cook_sb_vappend(Cook_String_Builder *sb, const char *fmt, va_list args);
 void cook_sb_reset(Cook_String_Builder *sb);
 void cook_sb_free(Cook_String_Builder *sb);
 Cook_String_View cook_sb_view(const Cook_String_Builder *sb);
-#define cook_sb_append(sb_ptr, fmt, ...)                             \
-    do {                                                             \
-        cook_temp_scope(1) {                                         \
-            const char *cstr = cook_temp_strfmt(fmt, ##__VA_ARGS__); \
-            size_t length = strlen(cstr);                            \
-            size_t size = COOK_ALIGN_UP(length, sizeof(uintptr_t));  \
-            cook_vec_grow(*(sb_ptr), size);                          \
-            memcpy(cook_vec_end(*(sb_ptr)), cstr, length);           \
-            cook_vec_header(*(sb_ptr))->size += length;              \
-        }                                                            \
-    } while (0)
+
+/*
+ * arena allocator
+ *
+ * A bump allocator over a caller-provided buffer. Allocations are aligned to
+ * the word size and released all at once with save/rewind/reset. An arena is
+ * owned by one thread at a time; pass the handle around to share it.
+ */
+typedef struct Cook_Arena {
+    unsigned char *data;
+    size_t capacity;
+    size_t used;
+} Cook_Arena;
+
+Cook_Arena cook_arena_from_buffer(void *buffer, size_t capacity);
+void *cook_arena_alloc(Cook_Arena *arena, size_t size);
+const char *cook_arena_strdup(Cook_Arena *arena, const char *cstr);
+const char *cook_arena_strndup(Cook_Arena *arena, const char *cstr, size_t n);
+const char *cook_arena_strsub(Cook_Arena *arena, const char *cstr, size_t begin, size_t end);
+const char *cook_arena_strfmt(Cook_Arena *arena, const char *fmt, ...);
+const char *cook_arena_vstrfmt(Cook_Arena *arena, const char *fmt, va_list args);
+const char *cook_arena_sv_to_cstr(Cook_Arena *arena, Cook_String_View sv);
+size_t cook_arena_save(const Cook_Arena *arena);
+void cook_arena_rewind(Cook_Arena *arena, size_t checkpoint);
+void cook_arena_reset(Cook_Arena *arena);
+#define cook_arena_scope(arena, id)                                      \
+    for (size_t _marked ## id = cook_arena_save(arena), _done ## id = 0; \
+         !_done ## id;                                                   \
+         cook_arena_rewind((arena), _marked ## id), _done ## id = 1)
 
 /*
  * temporary allocator (steal from https://github.com/tsoding/nob.h.git)
+ *
+ * Every thread has its own current arena, backed by a thread-local buffer of
+ * COOK_TEMP_BUFFER_CAPACITY bytes unless another arena is installed with
+ * cook_temp_set_arena(). The cook_temp_* functions operate on that arena.
  */
+#ifndef COOK_THREAD_LOCAL
+    #if defined(COOK_TEMP_SINGLE_THREADED)
+        #define COOK_THREAD_LOCAL
+    #elif defined(_MSC_VER)
+        #define COOK_THREAD_LOCAL __declspec(thread)
+    #else
+        #define COOK_THREAD_LOCAL __thread
+    #endif
+#endif
+
 #define COOK_TEMP_BUFFER_CAPACITY (1024*8)
+Cook_Arena *cook_temp_arena(void);
+Cook_Arena *cook_temp_set_arena(Cook_Arena *arena); /* NULL restores the default, returns the previous one (NULL: the default) */
 void *cook_temp_alloc(size_t size);
 const char *cook_temp_strdup(const char *cstr);
 const char *cook_temp_strndup(const char *cstr, size_t n);
@@ -215,10 +400,76 @@ void cook_temp_reset(void);
          !_done ## id;                                            \
          cook_temp_rewind(_marked ## id), _done ## id= 1)
 
+/*
+ * pool allocator
+ *
+ * Hands out objects of one fixed size from slabs that start on a cache line.
+ * Freed objects are threaded onto an intrusive free list, so allocating and
+ * freeing are O(1) and stay in the same few slabs. A pool is owned by one
+ * thread; threads sharing a pool each go through their own Cook_Pool_Cache,
+ * which moves objects to and from the pool in batches under its lock.
+ * Objects parked in a cache count as live until the cache is flushed.
+ */
+#define COOK_POOL_ALIGNMENT   64  /* slab alignment, one cache line */
+#define COOK_POOL_SLAB_SIZE   (1024*64)
+#define COOK_POOL_CACHE_BATCH 32
+
+typedef struct Cook_Pool_Slab {
+    struct Cook_Pool_Slab *next;
+    void *block; /* what malloc returned */
+} Cook_Pool_Slab;
+
+typedef struct Cook_Pool {
+    size_t object_size;
+    size_t slab_objects;      /* objects per slab */
+    Cook_Pool_Slab *slabs;
+    void *free_list;          /* every free object stores the next one */
+    unsigned char *fresh;     /* never handed out part of the newest slab */
+    unsigned char *fresh_end;
+    size_t slab_count;
+    size_t live;
+    size_t peak;
+    long lock;
+} Cook_Pool;
+
+typedef struct Cook_Pool_Stats {
+    size_t object_size;
+    size_t slab_count;
+    size_t capacity;  /* objects the slabs can hold */
+    size_t live;      /* objects handed out */
+    size_t peak;      /* highest 'live' so far */
+    size_t bytes;     /* memory held by the slabs */
+    double occupancy; /* live/capacity */
+} Cook_Pool_Stats;
+
+typedef struct Cook_Pool_Cache {
+    Cook_Pool *pool;
+    void *free_list;
+    size_t count;
+} Cook_Pool_Cache;
+
+void cook_pool_init(Cook_Pool *pool, size_t object_size);
+void *cook_pool_alloc(Cook_Pool *pool);
+void cook_pool_free(Cook_Pool *pool, void *ptr);
+void cook_pool_destroy(Cook_Pool *pool); /* releases every slab, live objects included */
+Cook_Pool_Stats cook_pool_stats(Cook_Pool *pool);
+void cook_pool_cache_init(Cook_Pool_Cache *cache, Cook_Pool *pool);
+void *cook_pool_cache_alloc(Cook_Pool_Cache *cache);
+void cook_pool_cache_free(Cook_Pool_Cache *cache, void *ptr);
+void cook_pool_cache_flush(Cook_Pool_Cache *cache); /* gives every parked object back to the pool */
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* COOK_H */
 
 #ifdef COOK_IMPLEMENTATION
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
 Cook_String_View cook_sv_from_cstr(const char *cstr)
 {
     return (Cook_String_View) {
@@ -279,7 +530,7 @@ bool cook_sv_empty(Cook_String_View sv)
 
 Cook_String_View cook_sv_slice(Cook_String_View sv, size_t begin, size_t end)
 {
-    Cook_String_View res = {0};
+    Cook_String_View res = {NULL, 0};
 
     if (begin >= end || end - begin > sv.length) return res; /* [begin, end) */
     res.data = sv.data + begin;
@@ -289,7 +540,7 @@ Cook_String_View cook_sv_slice(Cook_String_View sv, size_t begin, size_t end)
 
 Cook_String_View cook_sv_ltrim(Cook_String_View sv)
 {
-    Cook_String_View res = {0};
+    Cook_String_View res = {NULL, 0};
     for (size_t i = 0; i < sv.length; i++) {
         if (sv.data[i] == ' ' || sv.data[i] == '\t') continue;
         res.data = sv.data + i;
@@ -301,7 +552,7 @@ Cook_String_View cook_sv_ltrim(Cook_String_View sv)
 
 Cook_String_View cook_sv_rtrim(Cook_String_View sv)
 {
-    Cook_String_View res = {0};
+    Cook_String_View res = {NULL, 0};
     for (size_t i = sv.length; i > 0; i--) {
         if (sv.data[i-1] == ' ' || sv.data[i-1] == '\t') continue;
         res.data = sv.data;
@@ -319,22 +570,51 @@ Cook_String_View cook_sv_trim(Cook_String_View sv)
     return res;
 }
 
+void cook_sb_reserve(Cook_String_Builder *sb, size_t extra)
+{
+    cook_vec_reserve(*sb, cook_vec_size(*sb) + extra);
+}
+
 void cook_sb_append_sv(Cook_String_Builder *sb, Cook_String_View sv)
 {
-    size_t size = COOK_ALIGN_UP(sv.length, sizeof(uintptr_t));
-    cook_vec_grow(*sb, size);
-    memcpy(cook_vec_end(*sb), sv.data, sv.length);
-    cook_vec_header(*sb)->size += sv.length;
+    cook_sb_append_parts(sb, sv.data, sv.length);
 }
 
 void cook_sb_append_parts(Cook_String_Builder *sb, const char *data, size_t length)
 {
-    size_t size = COOK_ALIGN_UP(length, sizeof(uintptr_t));
-    cook_vec_grow(*sb, size);
+    if (length == 0) return;
+    cook_sb_reserve(sb, length);
     memcpy(cook_vec_end(*sb), data, length);
     cook_vec_header(*sb)->size += length;
 }
 
+void cook_sb_vappend(Cook_String_Builder *sb, const char *fmt, va_list args)
+{
+    va_list copy;
+    size_t avail = cook_vec_capacity(*sb) - cook_vec_size(*sb);
+
+    /* try the free tail first, only measure-and-retry when it is too small */
+    va_copy(copy, args);
+    int len = vsnprintf(avail ? cook_vec_end(*sb) : NULL, avail, fmt, copy);
+    va_end(copy);
+    if (len < 0) return;
+
+    if ((size_t)len >= avail) {
+        cook_sb_reserve(sb, (size_t)len + 1);
+        vsnprintf(cook_vec_end(*sb), (size_t)len + 1, fmt, args);
+    }
+    cook_vec_header(*sb)->size += (size_t)len;
+}
+
+void cook_sb_append(Cook_String_Builder *sb, const char *fmt, ...)
+{
+    va_list args;
+
+    va_start(args, fmt);
+    cook_sb_vappend(sb, fmt, args);
+    va_end(args);
+}
+
 void cook_sb_reset(Cook_String_Builder *sb)
 {
     cook_vec_reset(*sb);
@@ -353,51 +633,59 @@ Cook_String_View cook_sb_view(const Cook_String_Builder *sb)
     };
 }
 
-static unsigned char _temp_buffer[COOK_TEMP_BUFFER_CAPACITY] = {0};
-static size_t _temp_buffer_used = 0;
+Cook_Arena cook_arena_from_buffer(void *buffer, size_t capacity)
+{
+    return (Cook_Arena) {
+        .data = (unsigned char*)buffer,
+        .capacity = buffer ? capacity : 0,
+        .used = 0
+    };
+}
 
-void *cook_temp_alloc(size_t size)
+void *cook_arena_alloc(Cook_Arena *arena, size_t size)
 {
+    COOK_ASSERT(arena != NULL);
+
     if (size == 0) return NULL;
-    size_t aligned_used = COOK_ALIGN_UP(_temp_buffer_used, sizeof(uintptr_t));
-    if (aligned_used + size > COOK_TEMP_BUFFER_CAPACITY) return NULL;
-    void *ptr = _temp_buffer + aligned_used;
-    _temp_buffer_used = aligned_used + size;
+    size_t aligned_used = COOK_ALIGN_UP(arena->used, sizeof(uintptr_t));
+    if (aligned_used > arena->capacity || size > arena->capacity - aligned_used) return NULL;
+    void *ptr = arena->data + aligned_used;
+    arena->used = aligned_used + size;
     return ptr;
 }
 
-size_t cook_temp_save(void)
+size_t cook_arena_save(const Cook_Arena *arena)
 {
-    return _temp_buffer_used;
+    return arena->used;
 }
 
-void cook_temp_rewind(size_t checkpoint)
+void cook_arena_rewind(Cook_Arena *arena, size_t checkpoint)
 {
-    _temp_buffer_used = checkpoint;
+    arena->used = checkpoint;
 }
 
-void cook_temp_reset(void)
+void cook_arena_reset(Cook_Arena *arena)
 {
-    _temp_buffer_used = 0;
+    arena->used = 0;
 }
 
-const char *cook_temp_strdup(const char *cstr)
+const char *cook_arena_strdup(Cook_Arena *arena, const char *cstr)
 {
-    return cook_temp_strsub(cstr, 0, strlen(cstr) + 1);
+    return cook_arena_strsub(arena, cstr, 0, strlen(cstr) + 1);
 }
 
-const char *cook_temp_strndup(const char *cstr, size_t n)
+const char *cook_arena_strndup(Cook_Arena *arena, const char *cstr, size_t n)
 {
-    return cook_temp_strsub(cstr, 0, n);
+    return cook_arena_strsub(arena, cstr, 0, n);
 }
 
-const char *cook_temp_strsub(const char *cstr, size_t begin, size_t end)
+const char *cook_arena_strsub(Cook_Arena *arena, const char *cstr, size_t begin, size_t end)
 {
     if (!cstr || begin >= end) return NULL; /* [begin, end) */
 
     size_t sub_length = end - begin;
-    char *ptr = cook_temp_alloc(sub_length + 1);
-    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
+    char *ptr = (char*)cook_arena_alloc(arena, sub_length + 1);
+    COOK_ASSERT(ptr != NULL && "out of arena memory");
 
     for (size_t i = 0; i < sub_length ; i++) {
         ptr[i] = cstr[begin + i];
@@ -407,22 +695,107 @@ const char *cook_temp_strsub(const char *cstr, size_t begin, size_t end)
     return ptr;
 }
 
-const char *cook_temp_strfmt(const char *fmt, ...)
+const char *cook_arena_vstrfmt(Cook_Arena *arena, const char *fmt, va_list args)
 {
     if (!fmt) return NULL;
 
+    va_list copy;
+
+    va_copy(copy, args);
+    int len = vsnprintf(NULL, 0, fmt, copy);
+    va_end(copy);
+    if (len < 0) return NULL;
+
+    char *ptr = (char*)cook_arena_alloc(arena, (size_t)len + 1);
+    COOK_ASSERT(ptr != NULL && "out of arena memory");
+
+    vsnprintf(ptr, (size_t)len + 1, fmt, args);
+
+    return ptr;
+}
+
+const char *cook_arena_strfmt(Cook_Arena *arena, const char *fmt, ...)
+{
     va_list args;
 
     va_start(args, fmt);
-    int len = vsnprintf(NULL, 0, fmt, args);
+    const char *ptr = cook_arena_vstrfmt(arena, fmt, args);
     va_end(args);
-    if (len < 0) return NULL;
 
-    void *ptr = cook_temp_alloc((size_t)len + 1);
-    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
+    return ptr;
+}
+
+const char *cook_arena_sv_to_cstr(Cook_Arena *arena, Cook_String_View sv)
+{
+    char *ptr = (char*)cook_arena_alloc(arena, sv.length + 1);
+    COOK_ASSERT(ptr != NULL && "out of arena memory");
+    memcpy(ptr, sv.data, sv.length);
+    ptr[sv.length] = '\0';
+    return ptr;
+}
+
+static COOK_THREAD_LOCAL unsigned char _temp_buffer[COOK_TEMP_BUFFER_CAPACITY] = {0};
+static COOK_THREAD_LOCAL Cook_Arena _temp_default = {NULL, 0, 0};
+static COOK_THREAD_LOCAL Cook_Arena *_temp_current = NULL;
+
+Cook_Arena *cook_temp_arena(void)
+{
+    if (!_temp_current) {
+        /* addresses of thread-local objects are not constant, so bind lazily */
+        if (!_temp_default.data) _temp_default = cook_arena_from_buffer(_temp_buffer, COOK_TEMP_BUFFER_CAPACITY);
+        _temp_current = &_temp_default;
+    }
+    return _temp_current;
+}
+
+Cook_Arena *cook_temp_set_arena(Cook_Arena *arena)
+{
+    Cook_Arena *prev = _temp_current;
+    _temp_current = arena; /* NULL binds the default again on its next use */
+    return prev;
+}
+
+void *cook_temp_alloc(size_t size)
+{
+    return cook_arena_alloc(cook_temp_arena(), size);
+}
+
+size_t cook_temp_save(void)
+{
+    return cook_arena_save(cook_temp_arena());
+}
+
+void cook_temp_rewind(size_t checkpoint)
+{
+    cook_arena_rewind(cook_temp_arena(), checkpoint);
+}
+
+void cook_temp_reset(void)
+{
+    cook_arena_reset(cook_temp_arena());
+}
+
+const char *cook_temp_strdup(const char *cstr)
+{
+    return cook_arena_strdup(cook_temp_arena(), cstr);
+}
+
+const char *cook_temp_strndup(const char *cstr, size_t n)
+{
+    return cook_arena_strndup(cook_temp_arena(), cstr, n);
+}
+
+const char *cook_temp_strsub(const char *cstr, size_t begin, size_t end)
+{
+    return cook_arena_strsub(cook_temp_arena(), cstr, begin, end);
+}
+
+const char *cook_temp_strfmt(const char *fmt, ...)
+{
+    va_list args;
 
     va_start(args, fmt);
-    vsnprintf(ptr, (size_t)len + 1, fmt, args);
+    const char *ptr = cook_arena_vstrfmt(cook_temp_arena(), fmt, args);
     va_end(args);
 
     return ptr;
@@ -430,23 +803,176 @@ const char *cook_temp_strfmt(const char *fmt, ...)
 
 const char *cook_temp_sv_to_cstr(Cook_String_View sv)
 {
-    char *ptr = cook_temp_alloc(sv.length + 1);
-    COOK_ASSERT(ptr != NULL && "out of temporary buffer");
-    memcpy(ptr, sv.data, sv.length);
-    ptr[sv.length] = '\0';
+    return cook_arena_sv_to_cstr(cook_temp_arena(), sv);
+}
+
+#if defined(_MSC_VER)
+    #define cook_pool__lock(pool)   while (InterlockedExchange(&(pool)->lock, 1)) YieldProcessor()
+    #define cook_pool__unlock(pool) InterlockedExchange(&(pool)->lock, 0)
+#elif defined(__GNUC__)
+    #define cook_pool__lock(pool)   while (__atomic_exchange_n(&(pool)->lock, 1, __ATOMIC_ACQUIRE))
+    #define cook_pool__unlock(pool) __atomic_store_n(&(pool)->lock, 0, __ATOMIC_RELEASE)
+#else
+    #define cook_pool__lock(pool)   ((void)(pool))
+    #define cook_pool__unlock(pool) ((void)(pool))
+#endif
+
+static void cook_pool__grow(Cook_Pool *pool)
+{
+    size_t slab_size = COOK_POOL_ALIGNMENT + pool->slab_objects*pool->object_size;
+    void *block = malloc(slab_size + COOK_POOL_ALIGNMENT - 1);
+    COOK_ASSERT(block != NULL && "out of memory");
+
+    /* the slab header takes the first cache line, objects follow it */
+    unsigned char *base = (unsigned char*)COOK_ALIGN_UP((uintptr_t)block, COOK_POOL_ALIGNMENT);
+    Cook_Pool_Slab *slab = (Cook_Pool_Slab*)base;
+    slab->block = block;
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->slab_count++;
+
+    pool->fresh = base + COOK_POOL_ALIGNMENT;
+    pool->fresh_end = pool->fresh + pool->slab_objects*pool->object_size;
+}
+
+static void *cook_pool__take(Cook_Pool *pool)
+{
+    void *ptr = pool->free_list;
+
+    if (ptr) {
+        pool->free_list = *(void**)ptr;
+    } else {
+        /* carve lazily so a new slab is only touched as it is used */
+        if (pool->fresh == pool->fresh_end) cook_pool__grow(pool);
+        ptr = pool->fresh;
+        pool->fresh += pool->object_size;
+    }
+    if (++pool->live > pool->peak) pool->peak = pool->live;
+
+    return ptr;
+}
+
+static void cook_pool__give(Cook_Pool *pool, void *ptr)
+{
+    *(void**)ptr = pool->free_list;
+    pool->free_list = ptr;
+    pool->live--;
+}
+
+void cook_pool_init(Cook_Pool *pool, size_t object_size)
+{
+    COOK_ASSERT(object_size > 0);
+
+    memset(pool, 0, sizeof(*pool));
+    if (object_size < sizeof(void*)) object_size = sizeof(void*);
+    pool->object_size = COOK_ALIGN_UP(object_size, 2*sizeof(void*));
+    pool->slab_objects = (COOK_POOL_SLAB_SIZE - COOK_POOL_ALIGNMENT)/pool->object_size;
+    if (pool->slab_objects < 8) pool->slab_objects = 8;
+}
+
+void *cook_pool_alloc(Cook_Pool *pool)
+{
+    return cook_pool__take(pool);
+}
+
+void cook_pool_free(Cook_Pool *pool, void *ptr)
+{
+    if (ptr) cook_pool__give(pool, ptr);
+}
+
+void cook_pool_destroy(Cook_Pool *pool)
+{
+    Cook_Pool_Slab *slab = pool->slabs;
+    while (slab) {
+        Cook_Pool_Slab *next = slab->next;
+        free(slab->block);
+        slab = next;
+    }
+    cook_pool_init(pool, pool->object_size);
+}
+
+Cook_Pool_Stats cook_pool_stats(Cook_Pool *pool)
+{
+    Cook_Pool_Stats stats;
+
+    memset(&stats, 0, sizeof(stats));
+    cook_pool__lock(pool);
+    stats.object_size = pool->object_size;
+    stats.slab_count = pool->slab_count;
+    stats.capacity = pool->slab_count*pool->slab_objects;
+    stats.live = pool->live;
+    stats.peak = pool->peak;
+    stats.bytes = pool->slab_count*(COOK_POOL_ALIGNMENT + pool->slab_objects*pool->object_size);
+    stats.occupancy = stats.capacity ? (double)stats.live/(double)stats.capacity : 0.0;
+    cook_pool__unlock(pool);
+
+    return stats;
+}
+
+void cook_pool_cache_init(Cook_Pool_Cache *cache, Cook_Pool *pool)
+{
+    cache->pool = pool;
+    cache->free_list = NULL;
+    cache->count = 0;
+}
+
+static void cook_pool__drain(Cook_Pool_Cache *cache, size_t n)
+{
+    cook_pool__lock(cache->pool);
+    while (n-- > 0 && cache->free_list) {
+        void *ptr = cache->free_list;
+        cache->free_list = *(void**)ptr;
+        cache->count--;
+        cook_pool__give(cache->pool, ptr);
+    }
+    cook_pool__unlock(cache->pool);
+}
+
+void *cook_pool_cache_alloc(Cook_Pool_Cache *cache)
+{
+    if (!cache->free_list) {
+        cook_pool__lock(cache->pool);
+        for (size_t i = 0; i < COOK_POOL_CACHE_BATCH; i++) {
+            void *ptr = cook_pool__take(cache->pool);
+            *(void**)ptr = cache->free_list;
+            cache->free_list = ptr;
+        }
+        cook_pool__unlock(cache->pool);
+        cache->count += COOK_POOL_CACHE_BATCH;
+    }
+
+    void *ptr = cache->free_list;
+    cache->free_list = *(void**)ptr;
+    cache->count--;
+
     return ptr;
 }
 
+void cook_pool_cache_free(Cook_Pool_Cache *cache, void *ptr)
+{
+    if (!ptr) return;
+
+    *(void**)ptr = cache->free_list;
+    cache->free_list = ptr;
+    cache->count++;
+    if (cache->count >= 2*COOK_POOL_CACHE_BATCH) cook_pool__drain(cache, COOK_POOL_CACHE_BATCH);
+}
+
+void cook_pool_cache_flush(Cook_Pool_Cache *cache)
+{
+    cook_pool__drain(cache, cache->count);
+}
+
 void *cook_vec_resize(void *vec, size_t new_capacity, size_t item_size)
 {
     Cook_Vector_Header *new_header;
     size_t alloc_size = sizeof(Cook_Vector_Header) + new_capacity*item_size;
 
     if (vec) {
-        new_header = realloc(cook_vec_header(vec), alloc_size);
+        new_header = (Cook_Vector_Header*)realloc(cook_vec_header(vec), alloc_size);
         COOK_ASSERT(new_header != NULL && "out of memory");
     } else {
-        new_header = malloc(alloc_size);
+        new_header = (Cook_Vector_Header*)malloc(alloc_size);
         COOK_ASSERT(new_header != NULL && "out of memory");
         new_header->size = 0;
     }
@@ -455,6 +981,61 @@ void *cook_vec_resize(void *vec, size_t new_capacity, size_t item_size)
     return (void*)((char*)new_header + sizeof(Cook_Vector_Header));
 }
 
+size_t cook_vec_grow_capacity(size_t capacity, size_t needed)
+{
+    size_t new_capacity = capacity < 16 ? 16 : 2*capacity;
+    return new_capacity < needed ? needed : new_capacity;
+}
+
+void *cook_vec_resize_arena(Cook_Arena *arena, void *vec, size_t new_capacity, size_t item_size)
+{
+    Cook_Vector_Header *new_header;
+    size_t alloc_size = sizeof(Cook_Vector_Header) + new_capacity*item_size;
+
+    if (vec) {
+        Cook_Vector_Header *header = cook_vec_header(vec);
+        size_t old_size = sizeof(Cook_Vector_Header) + header->capacity*item_size;
+        size_t offset = (size_t)((unsigned char*)header - arena->data);
+
+        /* the last allocation of the arena can grow in place */
+        if (offset + old_size == arena->used && offset + alloc_size <= arena->capacity) {
+            arena->used = offset + alloc_size;
+            header->capacity = new_capacity;
+            return vec;
+        }
+
+        new_header = (Cook_Vector_Header*)cook_arena_alloc(arena, alloc_size);
+        COOK_ASSERT(new_header != NULL && "out of arena memory");
+        memcpy(new_header, header, sizeof(Cook_Vector_Header) + header->size*item_size);
+    } else {
+        new_header = (Cook_Vector_Header*)cook_arena_alloc(arena, alloc_size);
+        COOK_ASSERT(new_header != NULL && "out of arena memory");
+        new_header->size = 0;
+    }
+    new_header->capacity = new_capacity;
+
+    return (void*)((char*)new_header + sizeof(Cook_Vector_Header));
+}
+
+void *cook_svec_grow(void *heap, const void *inline_items, size_t size, size_t *capacity,
+                     size_t inline_capacity, size_t needed, size_t item_size)
+{
+    size_t new_capacity = cook_vec_grow_capacity(heap ? *capacity : inline_capacity, needed);
+    void *new_heap;
+
+    if (heap) {
+        new_heap = realloc(heap, new_capacity*item_size);
+        COOK_ASSERT(new_heap != NULL && "out of memory");
+    } else {
+        new_heap = malloc(new_capacity*item_size);
+        COOK_ASSERT(new_heap != NULL && "out of memory");
+        memcpy(new_heap, inline_items, size*item_size);
+    }
+    *capacity = new_capacity;
+
+    return new_heap;
+}
+
 static Cook_Mini_Hash_Bucket *cook_hash__find_bucket(Cook_Mini_Hash_Bucket *buckets, size_t capacity, size_t key)
 {
     size_t index = key % capacity;
@@ -473,7 +1054,7 @@ static bool cook_hash__expand(Cook_Mini_Hash *lookup, size_t new_capacity)
 {
     if (new_capacity <= lookup->capacity) return false;
 
-    Cook_Mini_Hash_Bucket *new_buckets = malloc(sizeof(Cook_Mini_Hash_Bucket)*new_capacity);
+    Cook_Mini_Hash_Bucket *new_buckets = (Cook_Mini_Hash_Bucket*)malloc(sizeof(Cook_Mini_Hash_Bucket)*new_capacity);
     if (!new_buckets) return false;
     for (size_t i = 0; i < new_capacity; i++) new_buckets[i].key = COOK_MINI_HASH_EMPTY;
 
@@ -534,6 +1115,103 @@ void cook_hash_free(Cook_Mini_Hash *lookup)
     lookup->count = 0;
 }
 
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+static bool cook__file_read(Cook_File_Map *map, FILE *f)
+{
+    char *data = NULL;
+    size_t size = 0, capacity = 0, n;
+
+    do {
+        if (size == capacity) {
+            char *grown;
+            capacity = capacity ? capacity*2 : 1024*16;
+            grown = (char*)realloc(data, capacity);
+            if (!grown) {
+                free(data);
+                return false;
+            }
+            data = grown;
+        }
+        n = fread(data + size, 1, capacity - size, f);
+        size += n;
+    } while (n > 0);
+
+    if (ferror(f) || size == 0) {
+        free(data);
+        return !ferror(f);
+    }
+    map->data = data;
+    map->count = size;
+    return true;
+}
+
+bool cook_file_map(Cook_File_Map *map, const char *path, unsigned hints)
+{
+    FILE *f;
+    bool ok;
+
+    COOK_ASSERT(map != NULL);
+    map->data = "";
+    map->count = 0;
+    map->mapped = false;
+
+#ifdef _WIN32
+    (void)hints;
+    f = fopen(path, "rb");
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t size = (size_t)st.st_size;
+        void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            close(fd);
+            if (hints & COOK_FILE_MAP_SEQUENTIAL) posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+            if (hints & COOK_FILE_MAP_WILLNEED) posix_madvise(data, size, POSIX_MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+            if (hints & COOK_FILE_MAP_HUGE_PAGES) madvise(data, size, MADV_HUGEPAGE);
+#endif
+            map->data = (const char*)data;
+            map->count = size;
+            map->mapped = true;
+            return true;
+        }
+    }
+
+    /* a pipe, a file of /proc that claims to be empty, or one mmap() refused */
+    f = fdopen(fd, "rb");
+    if (!f) close(fd);
+#endif
+    if (!f) return false;
+    ok = cook__file_read(map, f);
+    fclose(f);
+    return ok;
+}
+
+void cook_file_unmap(Cook_File_Map *map)
+{
+    COOK_ASSERT(map != NULL);
+
+    if (map->mapped) {
+#ifndef _WIN32
+        munmap((void*)map->data, map->count);
+#endif
+    } else if (map->count > 0) {
+        free((void*)map->data);
+    }
+    map->data = "";
+    map->count = 0;
+    map->mapped = false;
+}
+
 #ifdef _WIN32
 const char *cook_dll_geterr(void)
 {
@@ -550,6 +1228,10 @@ const char *cook_dll_geterr(void)
 }
 #endif
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* COOK_IMPLEMENTATION */
 
 #ifdef COOK_STRIP_PREFIX
@@ -567,6 +1249,29 @@ const char *cook_dll_geterr(void)
 #define vec_end            cook_vec_end
 #define vec_free           cook_vec_free
 #define vec_reset          cook_vec_reset
+#define vec_reserve        cook_vec_reserve
+#define vec_shrink         cook_vec_shrink
+#define vec_grow_capacity  cook_vec_grow_capacity
+#define vec_push_arena     cook_vec_push_arena
+#define vec_reserve_arena  cook_vec_reserve_arena
+#define vec_resize_arena   cook_vec_resize_arena
+
+#define Small_Vector       Cook_Small_Vector
+#define svec_init          cook_svec_init
+#define svec_data          cook_svec_data
+#define svec_size          cook_svec_size
+#define svec_capacity      cook_svec_capacity
+#define svec_inline        cook_svec_inline
+#define svec_empty         cook_svec_empty
+#define svec_end           cook_svec_end
+#define svec_reserve       cook_svec_reserve
+#define svec_push          cook_svec_push
+#define svec_pop           cook_svec_pop
+#define svec_reset         cook_svec_reset
+#define svec_shrink        cook_svec_shrink
+#define svec_free          cook_svec_free
+#define svec_foreach       cook_svec_foreach
+#define svec_grow          cook_svec_grow
 
 #define arr_size           cook_arr_size
 #define arr_foreach        cook_arr_foreach
@@ -587,16 +1292,46 @@ const char *cook_dll_geterr(void)
 #define OFFSET_OF          COOK_OFFSET_OF
 #define CONTAINER_OF       COOK_CONTAINER_OF
 
+#define Arena              Cook_Arena
+#define arena_from_buffer  cook_arena_from_buffer
+#define arena_alloc        cook_arena_alloc
+#define arena_strdup       cook_arena_strdup
+#define arena_strndup      cook_arena_strndup
+#define arena_strsub       cook_arena_strsub
+#define arena_strfmt       cook_arena_strfmt
+#define arena_vstrfmt      cook_arena_vstrfmt
+#define arena_sv_to_cstr   cook_arena_sv_to_cstr
+#define arena_save         cook_arena_save
+#define arena_rewind       cook_arena_rewind
+#define arena_reset        cook_arena_reset
+#define arena_scope        cook_arena_scope
+
+#define temp_arena         cook_temp_arena
+#define temp_set_arena     cook_temp_set_arena
 #define temp_alloc         cook_temp_alloc
 #define temp_strdup        cook_temp_strdup
 #define temp_strndup       cook_temp_strndup
 #define temp_strsub        cook_temp_strsub
 #define temp_strfmt        cook_temp_strfmt
+#define temp_sv_to_cstr    cook_temp_sv_to_cstr
 #define temp_save          cook_temp_save
 #define temp_rewind        cook_temp_rewind
 #define temp_reset         cook_temp_reset
 #define temp_scope         cook_temp_scope
 
+#define Pool               Cook_Pool
+#define Pool_Stats         Cook_Pool_Stats
+#define Pool_Cache         Cook_Pool_Cache
+#define pool_init          cook_pool_init
+#define pool_alloc         cook_pool_alloc
+#define pool_free          cook_pool_free
+#define pool_destroy       cook_pool_destroy
+#define pool_stats         cook_pool_stats
+#define pool_cache_init    cook_pool_cache_init
+#define pool_cache_alloc   cook_pool_cache_alloc
+#define pool_cache_free    cook_pool_cache_free
+#define pool_cache_flush   cook_pool_cache_flush
+
 #define sv_from_cstr       cook_sv_from_cstr
 #define sv_from_parts      cook_sv_from_parts
 #define sv_equal           cook_sv_equal
@@ -609,12 +1344,19 @@ const char *cook_dll_geterr(void)
 #define sv_ltrim           cook_sv_ltrim
 #define sv_rtrim           cook_sv_rtrim
 
+#define String_Builder     Cook_String_Builder
+#define sb_reserve         cook_sb_reserve
 #define sb_append_sv       cook_sb_append_sv
 #define sb_append_parts    cook_sb_append_parts
 #define sb_reset           cook_sb_reset
 #define sb_free            cook_sb_free
 #define sb_view            cook_sb_view
 #define sb_append          cook_sb_append
+#define sb_vappend         cook_sb_vappend
+
+#define File_Map           Cook_File_Map
+#define file_map           cook_file_map
+#define file_unmap         cook_file_unmap
 
 #endif /* COOK_STRIP_PREFIX */
 
@@ -0,0 +1,672 @@
+/*
+cook.hpp - v0.11 - Dylaris 2025
+===================================================
+
+BRIEF:
+  Typed C++17 containers over the memory layout of cook.h.
+
+NOTICE:
+  Every container here stores its items exactly like its C counterpart, so
+  data crosses the language boundary without copies:
+    cook::vec<T>          <-> T* managed by cook_vec_* (and a String_Builder
+                              is a cook::vec<char>)
+    cook::small_vec<T, N> <-> Cook_Small_Vector(T, N)
+    cook::arena           <-> Cook_Arena
+    cook::to_c()/to_std() <-> Cook_String_View
+  The containers only hold trivially copyable items, since the C side moves
+  them with realloc/memcpy. They are move-only: copying is always explicit.
+  Nothing here throws; running out of memory trips COOK_ASSERT like in C.
+
+USAGE:
+  Include this header from C++. It does not need the C implementation, but
+  any file may still define COOK_IMPLEMENTATION before including it.
+  ```
+    cook::small_vec<ffi_type*, 8> atypes;
+    atypes.push_back(&ffi_type_sint32);
+    ffi_prep_cif(&cif, abi, atypes.size(), rtype, atypes.data());
+  ```
+
+LICENSE:
+  See the end of cook.h for further details.
+*/
+
+#ifndef COOK_HPP
+#define COOK_HPP
+
+#include "cook.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace cook {
+
+/*
+ * capacity math and hashing
+ */
+constexpr std::size_t grow_capacity(std::size_t capacity, std::size_t needed) noexcept
+{
+    /* keep in sync with cook_vec_grow_capacity() */
+    std::size_t new_capacity = capacity < 16 ? 16 : 2*capacity;
+    return new_capacity < needed ? needed : new_capacity;
+}
+
+constexpr std::size_t align_up(std::size_t n, std::size_t align) noexcept
+{
+    return (n + align - 1) & ~(align - 1);
+}
+
+constexpr std::uint64_t fnv1a(const char *data, std::size_t length,
+                              std::uint64_t hash = 14695981039346656037ull) noexcept
+{
+    for (std::size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+constexpr std::uint64_t fnv1a(std::string_view sv) noexcept
+{
+    return fnv1a(sv.data(), sv.size());
+}
+
+/* the splitmix64 finalizer, spreads the bits of integer and pointer keys */
+constexpr std::uint64_t mix64(std::uint64_t x) noexcept
+{
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ull;
+    x ^= x >> 27; x *= 0x94d049bb133111ebull;
+    x ^= x >> 31;
+    return x;
+}
+
+static_assert(grow_capacity(0, 1) == 16 && grow_capacity(16, 17) == 32 && grow_capacity(16, 100) == 100);
+static_assert(fnv1a("") == 14695981039346656037ull && fnv1a("a") == 0xaf63dc4c8601ec8cull);
+
+/*
+ * string view
+ */
+constexpr Cook_String_View to_c(std::string_view sv) noexcept
+{
+    return Cook_String_View{sv.data(), sv.size()};
+}
+
+constexpr std::string_view to_std(Cook_String_View sv) noexcept
+{
+    return std::string_view(sv.data, sv.length);
+}
+
+template <class K, class = void>
+struct hash;
+
+template <class K>
+struct hash<K, std::enable_if_t<std::is_integral_v<K> || std::is_enum_v<K> || std::is_pointer_v<K>>> {
+    constexpr std::uint64_t operator()(K key) const noexcept
+    {
+        if constexpr (std::is_pointer_v<K>) return mix64((std::uint64_t)(std::uintptr_t)key);
+        else return mix64((std::uint64_t)key);
+    }
+};
+
+template <>
+struct hash<std::string_view> {
+    constexpr std::uint64_t operator()(std::string_view key) const noexcept { return fnv1a(key); }
+};
+
+template <>
+struct hash<Cook_String_View> {
+    constexpr std::uint64_t operator()(Cook_String_View key) const noexcept { return fnv1a(key.data, key.length); }
+};
+
+template <class K>
+struct equal {
+    constexpr bool operator()(const K &a, const K &b) const noexcept { return a == b; }
+};
+
+template <>
+struct equal<Cook_String_View> {
+    constexpr bool operator()(Cook_String_View a, Cook_String_View b) const noexcept { return to_std(a) == to_std(b); }
+};
+
+/*
+ * arena allocator
+ *
+ * Owns its buffer when constructed with a capacity, borrows it when given
+ * one. c() hands the underlying Cook_Arena to the C functions.
+ */
+class arena {
+public:
+    arena() noexcept : arena_{}, owned_(false) {}
+
+    explicit arena(std::size_t capacity) noexcept : arena_{}, owned_(true)
+    {
+        void *buffer = std::malloc(capacity);
+        COOK_ASSERT(buffer != NULL && "out of memory");
+        arena_.data = static_cast<unsigned char*>(buffer);
+        arena_.capacity = capacity;
+    }
+
+    arena(void *buffer, std::size_t capacity) noexcept : arena_{}, owned_(false)
+    {
+        arena_.data = static_cast<unsigned char*>(buffer);
+        arena_.capacity = buffer ? capacity : 0;
+    }
+
+    arena(const arena &) = delete;
+    arena &operator=(const arena &) = delete;
+
+    arena(arena &&other) noexcept : arena_(other.arena_), owned_(other.owned_)
+    {
+        other.arena_ = Cook_Arena{};
+        other.owned_ = false;
+    }
+
+    arena &operator=(arena &&other) noexcept
+    {
+        if (this != &other) {
+            if (owned_) std::free(arena_.data);
+            arena_ = other.arena_;
+            owned_ = other.owned_;
+            other.arena_ = Cook_Arena{};
+            other.owned_ = false;
+        }
+        return *this;
+    }
+
+    ~arena() { if (owned_) std::free(arena_.data); }
+
+    /* NULL when full or for a zero size, like cook_arena_alloc() */
+    void *alloc(std::size_t size, std::size_t align = alignof(void*)) noexcept
+    {
+        if (size == 0) return nullptr;
+        std::size_t offset = align_up((std::size_t)(std::uintptr_t)(arena_.data + arena_.used), align)
+                           - (std::size_t)(std::uintptr_t)arena_.data;
+        if (offset > arena_.capacity || size > arena_.capacity - offset) return nullptr;
+        arena_.used = offset + size;
+        return arena_.data + offset;
+    }
+
+    template <class T>
+    T *alloc_array(std::size_t n) noexcept
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "an arena never runs destructors");
+        return static_cast<T*>(alloc(n*sizeof(T), alignof(T)));
+    }
+
+    std::size_t save() const noexcept { return arena_.used; }
+    void rewind(std::size_t checkpoint) noexcept { arena_.used = checkpoint; }
+    void reset() noexcept { arena_.used = 0; }
+    std::size_t used() const noexcept { return arena_.used; }
+    std::size_t capacity() const noexcept { return arena_.capacity; }
+    Cook_Arena *c() noexcept { return &arena_; }
+
+private:
+    Cook_Arena arena_;
+    bool owned_;
+};
+
+/* lets standard containers live in an arena, deallocation is a no-op */
+template <class T>
+class arena_allocator {
+public:
+    using value_type = T;
+
+    explicit arena_allocator(arena &a) noexcept : arena_(&a) {}
+    template <class U>
+    arena_allocator(const arena_allocator<U> &other) noexcept : arena_(other.arena_) {}
+
+    T *allocate(std::size_t n) noexcept
+    {
+        void *ptr = arena_->alloc(n*sizeof(T), alignof(T));
+        COOK_ASSERT(ptr != NULL && "out of arena memory");
+        return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T *, std::size_t) noexcept {}
+
+    template <class U>
+    bool operator==(const arena_allocator<U> &other) const noexcept { return arena_ == other.arena_; }
+    template <class U>
+    bool operator!=(const arena_allocator<U> &other) const noexcept { return arena_ != other.arena_; }
+
+private:
+    template <class U> friend class arena_allocator;
+    arena *arena_;
+};
+
+/*
+ * dynamic array
+ *
+ * Holds the same pointer a C `T *vec` does: items preceded by a
+ * Cook_Vector_Header. adopt() takes over a heap vector built with the C
+ * macros, release() hands it back to be freed with cook_vec_free(). A vector
+ * bound to an arena grows inside it and is released with the arena.
+ */
+template <class T>
+class vec {
+    static_assert(std::is_trivially_copyable_v<T>, "the C side moves items with realloc/memcpy");
+
+public:
+    vec() noexcept = default;
+    explicit vec(arena &a) noexcept : arena_(&a) {}
+
+    vec(const vec &) = delete;
+    vec &operator=(const vec &) = delete;
+
+    vec(vec &&other) noexcept : items_(other.items_), arena_(other.arena_) { other.items_ = nullptr; }
+
+    vec &operator=(vec &&other) noexcept
+    {
+        if (this != &other) {
+            destroy();
+            items_ = std::exchange(other.items_, nullptr);
+            arena_ = other.arena_;
+        }
+        return *this;
+    }
+
+    ~vec() { destroy(); }
+
+    static vec adopt(T *items) noexcept
+    {
+        vec v;
+        v.items_ = items;
+        return v;
+    }
+
+    T *release() noexcept
+    {
+        COOK_ASSERT(arena_ == nullptr && "an arena vector cannot outlive its arena");
+        return std::exchange(items_, nullptr);
+    }
+
+    std::size_t size() const noexcept { return items_ ? header()->size : 0; }
+    std::size_t capacity() const noexcept { return items_ ? header()->capacity : 0; }
+    bool empty() const noexcept { return size() == 0; }
+    T *data() noexcept { return items_; }
+    const T *data() const noexcept { return items_; }
+    T *begin() noexcept { return items_; }
+    T *end() noexcept { return items_ + size(); }
+    const T *begin() const noexcept { return items_; }
+    const T *end() const noexcept { return items_ + size(); }
+    T &operator[](std::size_t i) noexcept { return items_[i]; }
+    const T &operator[](std::size_t i) const noexcept { return items_[i]; }
+    T &back() noexcept { return items_[size() - 1]; }
+
+    void reserve(std::size_t n) noexcept
+    {
+        if (n > capacity()) resize(grow_capacity(capacity(), n));
+    }
+
+    void push_back(const T &item) noexcept
+    {
+        T copy = item; /* 'item' may live inside the storage about to move */
+        if (size() + 1 > capacity()) reserve(size() + 1);
+        items_[header()->size++] = copy;
+    }
+
+    template <class... Args>
+    T &emplace_back(Args &&...args) noexcept
+    {
+        T tmp(std::forward<Args>(args)...); /* they may refer into the storage about to move */
+        if (size() + 1 > capacity()) reserve(size() + 1);
+        return *new (&items_[header()->size++]) T(tmp);
+    }
+
+    T pop_back() noexcept { return items_[--header()->size]; }
+    void clear() noexcept { if (items_) header()->size = 0; }
+
+    void shrink_to_fit() noexcept
+    {
+        if (arena_) return;
+        if (empty()) destroy();
+        else if (size() < capacity()) resize(size());
+    }
+
+private:
+    Cook_Vector_Header *header() const noexcept
+    {
+        return reinterpret_cast<Cook_Vector_Header*>(reinterpret_cast<char*>(items_) - sizeof(Cook_Vector_Header));
+    }
+
+    void destroy() noexcept
+    {
+        if (items_ && !arena_) std::free(header());
+        items_ = nullptr;
+    }
+
+    void resize(std::size_t new_capacity) noexcept
+    {
+        std::size_t alloc_size = sizeof(Cook_Vector_Header) + new_capacity*sizeof(T);
+        Cook_Vector_Header *new_header;
+
+        if (arena_) {
+            /* the arena's last allocation grows in place, as in cook_vec_resize_arena() */
+            Cook_Arena *a = arena_->c();
+            if (items_) {
+                std::size_t offset = (std::size_t)(reinterpret_cast<unsigned char*>(header()) - a->data);
+                if (offset + sizeof(Cook_Vector_Header) + capacity()*sizeof(T) == a->used &&
+                    offset + alloc_size <= a->capacity) {
+                    a->used = offset + alloc_size;
+                    header()->capacity = new_capacity;
+                    return;
+                }
+            }
+            new_header = static_cast<Cook_Vector_Header*>(arena_->alloc(alloc_size, alignof(std::max_align_t)));
+            COOK_ASSERT(new_header != NULL && "out of arena memory");
+            new_header->size = size();
+            if (items_) std::memcpy(new_header + 1, items_, size()*sizeof(T));
+        } else if (items_) {
+            new_header = static_cast<Cook_Vector_Header*>(std::realloc(header(), alloc_size));
+            COOK_ASSERT(new_header != NULL && "out of memory");
+        } else {
+            new_header = static_cast<Cook_Vector_Header*>(std::malloc(alloc_size));
+            COOK_ASSERT(new_header != NULL && "out of memory");
+            new_header->size = 0;
+        }
+        new_header->capacity = new_capacity;
+        items_ = reinterpret_cast<T*>(reinterpret_cast<char*>(new_header) + sizeof(Cook_Vector_Header));
+    }
+
+    T *items_ = nullptr;
+    arena *arena_ = nullptr;
+};
+
+/*
+ * small vector
+ *
+ * Same members in the same order as Cook_Small_Vector(T, N), so as<C>()
+ * views it as a C typedef of that struct.
+ */
+template <class T, std::size_t N>
+class small_vec {
+    static_assert(std::is_trivially_copyable_v<T>, "the C side moves items with realloc/memcpy");
+    static_assert(N > 0, "use cook::vec<T> without inline storage");
+
+public:
+    small_vec() noexcept : size_(0), capacity_(0), heap_(nullptr) {}
+
+    small_vec(const small_vec &) = delete;
+    small_vec &operator=(const small_vec &) = delete;
+
+    small_vec(small_vec &&other) noexcept : small_vec() { steal(other); }
+
+    small_vec &operator=(small_vec &&other) noexcept
+    {
+        if (this != &other) {
+            std::free(heap_);
+            steal(other);
+        }
+        return *this;
+    }
+
+    ~small_vec() { std::free(heap_); }
+
+    template <class C>
+    C *as() noexcept
+    {
+        static_assert(sizeof(C) == sizeof(small_vec) && alignof(C) == alignof(small_vec),
+                      "C must be Cook_Small_Vector(T, N)");
+        return reinterpret_cast<C*>(this);
+    }
+
+    std::size_t size() const noexcept { return size_; }
+    std::size_t capacity() const noexcept { return heap_ ? capacity_ : N; }
+    bool empty() const noexcept { return size_ == 0; }
+    bool is_inline() const noexcept { return heap_ == nullptr; }
+    T *data() noexcept { return heap_ ? heap_ : inline_items_; }
+    const T *data() const noexcept { return heap_ ? heap_ : inline_items_; }
+    T *begin() noexcept { return data(); }
+    T *end() noexcept { return data() + size_; }
+    const T *begin() const noexcept { return data(); }
+    const T *end() const noexcept { return data() + size_; }
+    T &operator[](std::size_t i) noexcept { return data()[i]; }
+    const T &operator[](std::size_t i) const noexcept { return data()[i]; }
+    T &back() noexcept { return data()[size_ - 1]; }
+
+    void reserve(std::size_t n) noexcept
+    {
+        if (n <= capacity()) return;
+
+        /* same policy as cook_svec_grow() */
+        std::size_t new_capacity = grow_capacity(capacity(), n);
+        T *new_heap;
+        if (heap_) {
+            new_heap = static_cast<T*>(std::realloc(heap_, new_capacity*sizeof(T)));
+            COOK_ASSERT(new_heap != NULL && "out of memory");
+        } else {
+            new_heap = static_cast<T*>(std::malloc(new_capacity*sizeof(T)));
+            COOK_ASSERT(new_heap != NULL && "out of memory");
+            std::memcpy(new_heap, inline_items_, size_*sizeof(T));
+        }
+        heap_ = new_heap;
+        capacity_ = new_capacity;
+    }
+
+    void push_back(const T &item) noexcept
+    {
+        T copy = item;
+        if (size_ + 1 > capacity()) reserve(size_ + 1);
+        data()[size_++] = copy;
+    }
+
+    template <class... Args>
+    T &emplace_back(Args &&...args) noexcept
+    {
+        T tmp(std::forward<Args>(args)...);
+        if (size_ + 1 > capacity()) reserve(size_ + 1);
+        return *new (&data()[size_++]) T(tmp);
+    }
+
+    T pop_back() noexcept { return data()[--size_]; }
+    void clear() noexcept { size_ = 0; }
+
+    void shrink_to_fit() noexcept
+    {
+        if (heap_ && size_ <= N) {
+            std::memcpy(inline_items_, heap_, size_*sizeof(T));
+            std::free(heap_);
+            heap_ = nullptr;
+            capacity_ = 0;
+        }
+    }
+
+private:
+    void steal(small_vec &other) noexcept
+    {
+        size_ = other.size_;
+        capacity_ = other.capacity_;
+        heap_ = other.heap_;
+        if (!heap_) std::memcpy(inline_items_, other.inline_items_, size_*sizeof(T));
+        other.size_ = 0;
+        other.capacity_ = 0;
+        other.heap_ = nullptr;
+    }
+
+    std::size_t size_;
+    std::size_t capacity_;
+    T *heap_;
+    T inline_items_[N];
+};
+
+/*
+ * hash map
+ *
+ * Open addressing with linear probing over a power-of-two bucket array, kept
+ * under the load factor of the C mini hash. Unlike the mini hash it stores
+ * real keys, so collisions are resolved, and erase shifts later entries back
+ * instead of leaving tombstones.
+ */
+template <class K, class V, class Hash = hash<K>, class Eq = equal<K>>
+class hash_map {
+    static_assert(std::is_trivially_copyable_v<K> && std::is_trivially_copyable_v<V>,
+                  "buckets are moved with memcpy");
+
+public:
+    struct bucket {
+        K key;
+        V value;
+    };
+
+    hash_map() noexcept = default;
+
+    hash_map(const hash_map &) = delete;
+    hash_map &operator=(const hash_map &) = delete;
+
+    hash_map(hash_map &&other) noexcept
+        : buckets_(std::exchange(other.buckets_, nullptr)), used_(std::exchange(other.used_, nullptr)),
+          capacity_(std::exchange(other.capacity_, 0)), count_(std::exchange(other.count_, 0)) {}
+
+    hash_map &operator=(hash_map &&other) noexcept
+    {
+        if (this != &other) {
+            std::free(buckets_);
+            buckets_ = std::exchange(other.buckets_, nullptr);
+            used_ = std::exchange(other.used_, nullptr);
+            capacity_ = std::exchange(other.capacity_, 0);
+            count_ = std::exchange(other.count_, 0);
+        }
+        return *this;
+    }
+
+    ~hash_map() { std::free(buckets_); }
+
+    std::size_t size() const noexcept { return count_; }
+    bool empty() const noexcept { return count_ == 0; }
+    std::size_t capacity() const noexcept { return capacity_; }
+
+    void reserve(std::size_t n) noexcept
+    {
+        std::size_t new_capacity = capacity_ < 16 ? 16 : capacity_;
+        while (n > max_count(new_capacity)) new_capacity *= 2;
+        if (new_capacity > capacity_) rehash(new_capacity);
+    }
+
+    /* returns false when the key was already there; its value is replaced */
+    bool insert(const K &key, const V &value) noexcept
+    {
+        bool inserted;
+        find_or_insert(key, inserted) = value;
+        return inserted;
+    }
+
+    /* the value for 'key', value-initialized if the key is new */
+    V &operator[](const K &key) noexcept
+    {
+        bool inserted;
+        V &value = find_or_insert(key, inserted);
+        if (inserted) value = V();
+        return value;
+    }
+
+    V *find(const K &key) noexcept
+    {
+        if (count_ == 0) return nullptr;
+        std::size_t i = slot(key);
+        return used_[i] ? &buckets_[i].value : nullptr;
+    }
+
+    const V *find(const K &key) const noexcept { return const_cast<hash_map*>(this)->find(key); }
+    bool contains(const K &key) const noexcept { return find(key) != nullptr; }
+
+    bool erase(const K &key) noexcept
+    {
+        if (count_ == 0) return false;
+        std::size_t i = slot(key);
+        if (!used_[i]) return false;
+
+        /* backward shift: pull later entries of the run into the hole */
+        std::size_t mask = capacity_ - 1;
+        for (std::size_t j = (i + 1) & mask; used_[j]; j = (j + 1) & mask) {
+            std::size_t home = (std::size_t)Hash{}(buckets_[j].key) & mask;
+            if (((j - home) & mask) >= ((j - i) & mask)) {
+                buckets_[i] = buckets_[j];
+                i = j;
+            }
+        }
+        used_[i] = 0;
+        count_--;
+        return true;
+    }
+
+    void clear() noexcept
+    {
+        if (used_) std::memset(used_, 0, capacity_);
+        count_ = 0;
+    }
+
+    template <class F>
+    void for_each(F &&f)
+    {
+        for (std::size_t i = 0; i < capacity_; i++) {
+            if (used_[i]) f(const_cast<const K &>(buckets_[i].key), buckets_[i].value);
+        }
+    }
+
+private:
+    static constexpr std::size_t max_count(std::size_t capacity) noexcept
+    {
+        return (std::size_t)(capacity*COOK_MINI_HASH_MAX_LOAD);
+    }
+
+    /* the bucket holding 'key', or the empty one where it would go */
+    std::size_t slot(const K &key) const noexcept
+    {
+        std::size_t mask = capacity_ - 1;
+        std::size_t i = (std::size_t)Hash{}(key) & mask;
+        while (used_[i] && !Eq{}(buckets_[i].key, key)) i = (i + 1) & mask;
+        return i;
+    }
+
+    V &find_or_insert(const K &key, bool &inserted) noexcept
+    {
+        if (count_ + 1 > max_count(capacity_)) reserve(count_ + 1);
+        std::size_t i = slot(key);
+        inserted = !used_[i];
+        if (inserted) {
+            used_[i] = 1;
+            std::memcpy(&buckets_[i].key, &key, sizeof(K));
+            count_++;
+        }
+        return buckets_[i].value;
+    }
+
+    void rehash(std::size_t new_capacity) noexcept
+    {
+        /* buckets and their used flags share one allocation */
+        std::size_t flags_offset = align_up(new_capacity*sizeof(bucket), alignof(std::max_align_t));
+        void *block = std::malloc(flags_offset + new_capacity);
+        COOK_ASSERT(block != NULL && "out of memory");
+
+        bucket *old_buckets = buckets_;
+        unsigned char *old_used = used_;
+        std::size_t old_capacity = capacity_;
+
+        buckets_ = static_cast<bucket*>(block);
+        used_ = static_cast<unsigned char*>(block) + flags_offset;
+        capacity_ = new_capacity;
+        std::memset(used_, 0, new_capacity);
+
+        for (std::size_t i = 0; i < old_capacity; i++) {
+            if (!old_used[i]) continue;
+            std::size_t j = slot(old_buckets[i].key);
+            used_[j] = 1;
+            std::memcpy(&buckets_[j], &old_buckets[i], sizeof(bucket));
+        }
+        std::free(old_buckets);
+    }
+
+    bucket *buckets_ = nullptr;
+    unsigned char *used_ = nullptr;
+    std::size_t capacity_ = 0;
+    std::size_t count_ = 0;
+};
+
+} /* namespace cook */
+
+#endif /* COOK_HPP */
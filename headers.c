@@ -0,0 +1,16 @@
+/* The implementations of the single-file headers main.c uses.
+ *
+ * They are the bulk of what main.c would compile, and they change far less
+ * often than main.c does, so `./nob` compiles this file into an object of
+ * its own, once, and links it with main.o. Their configuration lives here
+ * too: it only changes the implementations, not the declarations main.c
+ * sees. The release builds compile both files in one command, for LTO and
+ * PGO to see all of it.
+ */
+#define COOK_IMPLEMENTATION
+#include "cook.h"
+
+#define STB_C_LEXER_IMPLEMENTATION
+#define STB_C_LEXER_REPL_PROFILE
+#define STB_C_LEX_ZERO_COPY Y  /* the REPL ends strings in place, in its input */
+#include "stb_c_lexer.h"
@@ -1,15 +1,27 @@
+#define _GNU_SOURCE           /* dlinfo() */
 #include <stdio.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <time.h>
 #include <dlfcn.h>
+#include <link.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <ffi.h>
 
-#define COOK_IMPLEMENTATION
+/* their implementations, and how the lexer is configured, are in headers.c */
 #define COOK_STRIP_PREFIX
 #include "cook.h"
-
-#define STB_C_LEXER_IMPLEMENTATION
 #include "stb_c_lexer.h"
 
+#define RAYLIB_PATH "raylib/lib/libraylib.so"
+
 typedef void (*fn_t)(void);
 
 // Color, 4 components, R8G8B8A8 (32bit)
@@ -20,99 +32,822 @@ typedef struct Color {
     unsigned char a;        // Color alpha value
 } Color;
 
-int main(void)
+static ffi_type ffi_type_color;  /* raylib struct Color */
+static ffi_type *ffi_type_color_elements[5];
+
+/* identifiers, for the whole session */
+#define MAX_ATOMS 4096
+static char atom_memory[STB_C_LEX_ATOMS_MEMORY(MAX_ATOMS, MAX_ATOMS*32)];
+static stb_lex_atoms atoms;
+
+/* a raylib function by atom, so dlsym() runs once per distinct name */
+typedef struct Symbol {
+    fn_t fn;
+    bool resolved;
+} Symbol;
+
+static Symbol *symbols = NULL;
+
+static fn_t find_symbol(void *lib, int atom, const char *name)
+{
+    if (atom < 0) return (fn_t) dlsym(lib, name); /* the atom table is full */
+    while (vec_size(symbols) <= (size_t) atom) vec_push(symbols, (Symbol){0});
+    if (!symbols[atom].resolved) {
+        symbols[atom].fn = (fn_t) dlsym(lib, name);
+        symbols[atom].resolved = true;
+    }
+    return symbols[atom].fn;
+}
+
+/* storage for one argument value, handed to ffi_call() */
+typedef union Arg_Slot {
+    int i;
+    const char *s;
+    Color color;
+} Arg_Slot;
+
+static int repl(void *raylib)
 {
-    void *raylib;             /* dll handle */
     ffi_status status;
     ffi_cif cif = {0};
-    ffi_type **atypes = NULL; /* array of arg type pointer */
-    void **avalues = NULL;    /* array of arg value pointer */
+    Small_Vector(ffi_type*, 8) atypes = {0}; /* array of arg type pointer */
+    Small_Vector(void*, 8) avalues = {0};    /* array of arg value pointer */
     const char *funcname;
+    int funcatom;
     fn_t fn;                  /* function to call */
     char inbuf[256];          /* store input */
-    char strbuf[64];          /* store string */
+    char strbuf[sizeof(inbuf)]; /* decoded escaped strings, never longer than the input */
     stb_lexer lex;
-    ffi_type ffi_type_color;  /* raylib struct Color */
+    Pool slots;               /* argument values */
 
-    ffi_type_color.size = sizeof(Color);
-    ffi_type_color.alignment = 1;
-    ffi_type_color.type = FFI_TYPE_STRUCT;
-    ffi_type_color.elements = (ffi_type **) temp_alloc(sizeof(ffi_type*)*5);
-    ffi_type_color.elements[0] = &ffi_type_uint8;
-    ffi_type_color.elements[1] = &ffi_type_uint8;
-    ffi_type_color.elements[2] = &ffi_type_uint8;
-    ffi_type_color.elements[3] = &ffi_type_uint8;
-    ffi_type_color.elements[4] = NULL;
-
-    raylib = dlopen("raylib/lib/libraylib.so", RTLD_NOW);
-    if (!raylib) {
-        fprintf(stderr, "ERROR: %s\n", dlerror());
-        return 1;
-    }
+    pool_init(&slots, sizeof(Arg_Slot));
 
     while (1) {
-        vec_reset(atypes);
-        vec_reset(avalues);
+        svec_foreach(void*, &avalues, value) pool_free(&slots, *value);
+        svec_reset(&atypes);
+        svec_reset(&avalues);
         fn = NULL;
         funcname = NULL;
+        funcatom = -1;
 
         printf("> ");
         fflush(stdout);
         if (!fgets(inbuf, sizeof(inbuf), stdin)) break;
 
         stb_c_lexer_init(&lex, inbuf, inbuf + strlen(inbuf), strbuf, sizeof(strbuf));
+        stb_c_lexer_set_atoms(&lex, &atoms);
 
         temp_scope(1) {
             while (stb_c_lexer_get_token(&lex)) {
                 switch (lex.token) {
                 case CLEX_id:
-                    funcname = temp_strdup(lex.string);
+                    funcatom = lex.atom;
+                    funcname = funcatom >= 0 ? stb_c_lexer_atom_name(&atoms, funcatom, NULL)
+                                             : temp_strndup(lex.string, lex.string_len);
                     break;
                 case CLEX_dqstring: {
-                    const char **x = temp_alloc(sizeof(char *));
-                    *x = temp_strdup(lex.string);
-                    vec_push(avalues, (void *) x);
-                    vec_push(atypes, &ffi_type_pointer);
+                    Arg_Slot *x = pool_alloc(&slots);
+                    /* a view into inbuf ends at the closing quote, which is already lexed */
+                    lex.string[lex.string_len] = '\0';
+                    x->s = lex.string;
+                    svec_push(&avalues, (void *) &x->s);
+                    svec_push(&atypes, &ffi_type_pointer);
                 } break;
                 case CLEX_intlit: {
-                    int *x = temp_alloc(sizeof(int));
-                    *x = (int) lex.int_number;
-                    vec_push(avalues, (void *) x);
-                    vec_push(atypes, &ffi_type_sint32);
+                    Arg_Slot *x = pool_alloc(&slots);
+                    x->i = (int) lex.int_number;
+                    svec_push(&avalues, (void *) &x->i);
+                    svec_push(&atypes, &ffi_type_sint32);
                 } break;
                 default:
                     if (lex.token == '@') {
                         /* parse to Color */
-                        Color *color = temp_alloc(sizeof(Color));
+                        Color *color = &((Arg_Slot *) pool_alloc(&slots))->color;
                         stb_c_lexer_get_token(&lex); color->r = (unsigned char) lex.int_number;
                         stb_c_lexer_get_token(&lex); color->g = (unsigned char) lex.int_number;
                         stb_c_lexer_get_token(&lex); color->b = (unsigned char) lex.int_number;
                         stb_c_lexer_get_token(&lex); color->a = (unsigned char) lex.int_number;
-                        vec_push(avalues, (void *) color);
-                        vec_push(atypes, &ffi_type_color);
+                        svec_push(&avalues, (void *) color);
+                        svec_push(&atypes, &ffi_type_color);
                     }
                 }
             }
 
-            if (vec_size(atypes) == 0) vec_push(atypes, &ffi_type_void);
+            if (svec_empty(&atypes)) svec_push(&atypes, &ffi_type_void);
 
             if (!funcname) goto end;
 
-            status = ffi_prep_cif(&cif, FFI_DEFAULT_ABI, vec_size(atypes), &ffi_type_void, atypes);
+            status = ffi_prep_cif(&cif, FFI_DEFAULT_ABI, svec_size(&atypes), &ffi_type_void, svec_data(&atypes));
             if (status != FFI_OK) {
                 fprintf(stderr, "ERROR: failed to call ffi_prep_cif()\n");
                 return 1;
             }
 
-            fn = (fn_t) dlsym(raylib, funcname);
-            if (fn) ffi_call(&cif, fn, NULL, avalues);
+            fn = find_symbol(raylib, funcatom, funcname);
+            if (fn) ffi_call(&cif, fn, NULL, svec_data(&avalues));
 end:
         }
     }
 
-    if (atypes) vec_free(atypes);
-    if (avalues) vec_free(avalues);
-    dlclose(raylib);
+    svec_foreach(void*, &avalues, value) pool_free(&slots, *value);
+    svec_free(&atypes);
+    svec_free(&avalues);
+    pool_destroy(&slots);
 
     return 0;
 }
+
+/*
+ * script compiler
+ *
+ * A script holds one call per line in the syntax of the repl. It is compiled
+ * once into an array of calls over a flat array of arguments, then linked
+ * against raylib and run. The file is mapped and split at line boundaries
+ * into chunks that worker threads compile independently, each with its own
+ * atom table and output arrays and counting lines from the start of its
+ * chunk. Concatenating the chunks in order turns local line numbers, atoms
+ * and offsets into global ones.
+ *
+ * A compiled script holds no pointers, so it is also written to a cache
+ * file and mapped as is by later runs of the same script.
+ */
+#define CHUNKS_PER_JOB  4                  /* so a slow chunk doesn't hold up the others */
+#define MIN_CHUNK_SIZE  (1024*64)
+
+typedef enum Arg_Kind {
+    ARG_INT,
+    ARG_STRING,
+    ARG_COLOR,
+} Arg_Kind;
+
+typedef struct Arg {
+    Arg_Kind kind;
+    union {
+        int i;
+        size_t s;             /* offset into Script.strings */
+        Color color;
+    } value;
+} Arg;
+
+typedef struct Call {
+    int atom;                 /* of the function name, chunk-local until concatenated */
+    int line;                 /* chunk-local until concatenated */
+    int arg_count;
+    size_t first_arg;         /* index into the args of the chunk, then of the script */
+} Call;
+
+typedef struct Script_Error {
+    int line;
+    const char *message;
+} Script_Error;
+
+typedef struct Chunk {
+    const char *begin;
+    const char *end;          /* just past a newline, or the end of the file */
+    int lines;
+    Call *calls;
+    Arg *args;
+    String_Builder strings;   /* 0-terminated string arguments */
+    Script_Error *errors;
+    char *atom_memory;
+    stb_lex_atoms atoms;
+    int *remap;               /* chunk atom to global atom */
+    int base_line;            /* where the chunk goes in the script */
+    size_t base_call;
+    size_t base_arg;
+    size_t base_string;
+} Chunk;
+
+typedef struct Script {
+    Call *calls;
+    size_t call_count;
+    Arg *args;
+    size_t arg_count;
+    char *strings;
+    size_t strings_size;
+    File_Map cache;           /* the cache file the arrays point into, if loaded from one */
+} Script;
+
+typedef struct Compiler Compiler;
+struct Compiler {
+    Chunk *chunks;
+    Script *script;
+    void (*step)(Compiler *compiler, Chunk *chunk);
+    atomic_size_t next_chunk;
+};
+
+/* compiles the line in lex into one call; returns an error message or NULL */
+static const char *compile_line(Chunk *chunk, stb_lexer *lex)
+{
+    Call call = {0};
+    bool has_name = false;
+    const char *message = NULL;
+
+    call.line = chunk->lines + 1;
+    call.first_arg = vec_size(chunk->args);
+
+    while (!message && stb_c_lexer_get_token(lex)) {
+        Arg arg = {0};
+        switch (lex->token) {
+        case CLEX_id:
+            if (has_name || call.arg_count) message = "the function name must come first, and only once";
+            else if (lex->atom < 0) message = "too many distinct function names";
+            has_name = true;
+            call.atom = lex->atom;
+            continue;
+        case CLEX_dqstring:
+            arg.kind = ARG_STRING;
+            arg.value.s = vec_size(chunk->strings);
+            sb_append_parts(&chunk->strings, lex->string, lex->string_len);
+            vec_push(chunk->strings, '\0');
+            break;
+        case CLEX_intlit:
+            arg.kind = ARG_INT;
+            arg.value.i = (int) lex->int_number;
+            break;
+        case '@': {
+            unsigned char *components = &arg.value.color.r;
+            arg.kind = ARG_COLOR;
+            for (int k = 0; k < 4 && !message; k++) {
+                if (!stb_c_lexer_get_token(lex) || lex->token != CLEX_intlit) message = "expected 4 integers after @";
+                else components[k] = (unsigned char) lex->int_number;
+            }
+        } break;
+        default:
+            message = "unexpected token";
+        }
+        vec_push(chunk->args, arg);
+        call.arg_count++;
+    }
+
+    if (!message && lex->token == CLEX_parse_error) message = "malformed token";
+    if (!message && !has_name && call.arg_count) message = "missing function name";
+    if (message) {
+        if (chunk->args) vec_header(chunk->args)->size = call.first_arg;
+        return message;
+    }
+    if (has_name) vec_push(chunk->calls, call);
+    return NULL;
+}
+
+static void compile_chunk(Compiler *compiler, Chunk *chunk)
+{
+    size_t atom_memory_size = STB_C_LEX_ATOMS_MEMORY(MAX_ATOMS, MAX_ATOMS*32);
+    char *store = NULL;       /* decoded strings of the current line */
+    stb_lexer lex;
+
+    (void) compiler;
+    chunk->atom_memory = malloc(atom_memory_size);
+    stb_c_lexer_atoms_init(&chunk->atoms, chunk->atom_memory, (int) atom_memory_size, MAX_ATOMS);
+
+    for (const char *line = chunk->begin; line < chunk->end; chunk->lines++) {
+        const char *eol = memchr(line, '\n', chunk->end - line);
+        if (!eol) eol = chunk->end;
+
+        vec_reserve(store, (size_t) (eol - line) + 1);
+        stb_c_lexer_init(&lex, line, eol, store, (int) (eol - line) + 1);
+        stb_c_lexer_set_atoms(&lex, &chunk->atoms);
+
+        const char *message = compile_line(chunk, &lex);
+        if (message) vec_push(chunk->errors, ((Script_Error) {chunk->lines + 1, message}));
+        line = eol + 1;
+    }
+
+    vec_free(store);
+}
+
+/* moves the output of a compiled chunk to its place in the script */
+static void place_chunk(Compiler *compiler, Chunk *chunk)
+{
+    Script *script = compiler->script;
+    Call *calls = script->calls + chunk->base_call;
+    Arg *args = script->args + chunk->base_arg;
+
+    vec_foreach(Call, chunk->calls, call) {
+        Call global = *call;
+        global.line += chunk->base_line;
+        global.first_arg += chunk->base_arg;
+        global.atom = chunk->remap[call->atom];
+        *calls++ = global;
+    }
+    vec_foreach(Arg, chunk->args, arg) {
+        Arg global = *arg;
+        if (global.kind == ARG_STRING) global.value.s += chunk->base_string;
+        *args++ = global;
+    }
+    if (chunk->strings) memcpy(script->strings + chunk->base_string, chunk->strings, vec_size(chunk->strings));
+
+    vec_free(chunk->calls);
+    vec_free(chunk->args);
+    vec_free(chunk->strings);
+}
+
+static void *compile_worker(void *arg)
+{
+    Compiler *compiler = arg;
+
+    for (;;) {
+        size_t i = atomic_fetch_add(&compiler->next_chunk, 1);
+        if (i >= vec_size(compiler->chunks)) break;
+        compiler->step(compiler, &compiler->chunks[i]);
+    }
+    return NULL;
+}
+
+/* runs step over every chunk on jobs threads, the calling one included */
+static void run_step(Compiler *compiler, int jobs, void (*step)(Compiler *compiler, Chunk *chunk))
+{
+    pthread_t *threads = NULL;
+
+    compiler->step = step;
+    atomic_store(&compiler->next_chunk, 0);
+    if ((size_t) jobs > vec_size(compiler->chunks)) jobs = (int) vec_size(compiler->chunks);
+    for (int i = 1; i < jobs; i++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, compile_worker, compiler) != 0) break; /* fewer workers will do */
+        vec_push(threads, thread);
+    }
+    compile_worker(compiler);
+    vec_foreach(pthread_t, threads, thread) pthread_join(*thread, NULL);
+    vec_free(threads);
+}
+
+/* compiles source on jobs threads into script; reports errors against path */
+static bool compile_script(const char *path, const char *source, size_t size, int jobs, Script *script)
+{
+    Compiler compiler = {0};
+    size_t chunk_size = size / ((size_t) jobs*CHUNKS_PER_JOB) + 1;
+    size_t calls = 0, args = 0, strings = 0;
+    int lines = 0;
+    bool ok = true;
+
+    if (chunk_size < MIN_CHUNK_SIZE) chunk_size = MIN_CHUNK_SIZE;
+    for (const char *begin = source, *end; begin < source + size; begin = end) {
+        end = (size_t) (source + size - begin) > chunk_size ? begin + chunk_size : source + size;
+        const char *newline = memchr(end - 1, '\n', source + size - (end - 1));
+        if (newline) end = newline + 1;
+        else end = source + size;
+        vec_push(compiler.chunks, ((Chunk) {.begin = begin, .end = end}));
+    }
+
+    run_step(&compiler, jobs, compile_chunk);
+
+    /* the only serial part: offsets of every chunk, and its atoms in the global table */
+    vec_foreach(Chunk, compiler.chunks, chunk) {
+        vec_foreach(Script_Error, chunk->errors, error) {
+            fprintf(stderr, "%s:%d: ERROR: %s\n", path, lines + error->line, error->message);
+            ok = false;
+        }
+        for (int atom = 0; atom < chunk->atoms.count; atom++) {
+            int length;
+            const char *name = stb_c_lexer_atom_name(&chunk->atoms, atom, &length);
+            int global = stb_c_lexer_intern(&atoms, name, length);
+            if (global < 0 && ok) {
+                fprintf(stderr, "%s: ERROR: too many distinct function names\n", path);
+                ok = false;
+            }
+            vec_push(chunk->remap, global);
+        }
+        chunk->base_line = lines;
+        chunk->base_call = calls;
+        chunk->base_arg = args;
+        chunk->base_string = strings;
+        lines += chunk->lines;
+        calls += vec_size(chunk->calls);
+        args += vec_size(chunk->args);
+        strings += vec_size(chunk->strings);
+    }
+
+    script->call_count = calls;
+    script->arg_count = args;
+    script->strings_size = strings;
+    script->calls = malloc(calls*sizeof(Call) + 1);
+    script->args = malloc(args*sizeof(Arg) + 1);
+    script->strings = malloc(strings + 1);
+    compiler.script = script;
+    if (ok) run_step(&compiler, jobs, place_chunk);
+
+    vec_foreach(Chunk, compiler.chunks, chunk) {
+        vec_free(chunk->calls); /* already moved unless there were errors */
+        vec_free(chunk->args);
+        vec_free(chunk->strings);
+        vec_free(chunk->errors);
+        vec_free(chunk->remap);
+        free(chunk->atom_memory);
+    }
+    vec_free(compiler.chunks);
+    return ok;
+}
+
+/* resolves the function of every call of script in raylib */
+static bool link_script(void *lib, const char *path, const Script *script)
+{
+    bool ok = true;
+
+    for (size_t i = 0; i < script->call_count; i++) {
+        const Call *call = &script->calls[i];
+        const char *name = stb_c_lexer_atom_name(&atoms, call->atom, NULL);
+        if (!find_symbol(lib, call->atom, name)) {
+            fprintf(stderr, "%s:%d: ERROR: unknown function `%s`\n", path, call->line, name);
+            ok = false;
+        }
+    }
+    return ok;
+}
+
+static void execute_script(const Script *script)
+{
+    ffi_cif cif;
+    Small_Vector(ffi_type*, 8) atypes;
+    Small_Vector(void*, 8) avalues;
+    Small_Vector(const char*, 8) strings; /* string arguments as pointers */
+
+    svec_init(&atypes);
+    svec_init(&avalues);
+    svec_init(&strings);
+
+    for (const Call *call = script->calls; call < script->calls + script->call_count; call++) {
+        svec_reset(&atypes);
+        svec_reset(&avalues);
+        svec_reset(&strings);
+        svec_reserve(&strings, (size_t) call->arg_count); /* avalues point into it */
+
+        for (int k = 0; k < call->arg_count; k++) {
+            const Arg *arg = &script->args[call->first_arg + k];
+            switch (arg->kind) {
+            case ARG_INT:
+                svec_push(&avalues, (void *) &arg->value.i);
+                svec_push(&atypes, &ffi_type_sint32);
+                break;
+            case ARG_STRING:
+                svec_push(&strings, script->strings + arg->value.s);
+                svec_push(&avalues, (void *) &svec_data(&strings)[svec_size(&strings) - 1]);
+                svec_push(&atypes, &ffi_type_pointer);
+                break;
+            case ARG_COLOR:
+                svec_push(&avalues, (void *) &arg->value.color);
+                svec_push(&atypes, &ffi_type_color);
+                break;
+            }
+        }
+
+        if (ffi_prep_cif(&cif, FFI_DEFAULT_ABI, svec_size(&atypes), &ffi_type_void, svec_data(&atypes)) != FFI_OK) {
+            fprintf(stderr, "ERROR: failed to call ffi_prep_cif()\n");
+            break;
+        }
+        ffi_call(&cif, symbols[call->atom].fn, NULL, svec_data(&avalues));
+    }
+
+    svec_free(&atypes);
+    svec_free(&avalues);
+    svec_free(&strings);
+}
+
+/*
+ * script cache
+ *
+ * SCRIPT_CACHE_DIR/<key> holds a compiled script: a header, then the calls,
+ * the arguments, the strings and the names of the atoms the calls refer to,
+ * each section right after the previous one. The key hashes the source and
+ * the build-id of raylib. The header repeats both, and the layout of the
+ * arrays, so a cache file that belongs to another source, library or build
+ * of main is stale and gets compiled and written again.
+ */
+#define SCRIPT_CACHE_DIR     ".cache/"
+#define SCRIPT_CACHE_MAGIC   0x3148434143534646ull /* "FFSCACH1" */
+#define SCRIPT_CACHE_VERSION 1
+
+typedef struct Script_Cache_Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t layout;          /* sizeof(Call) << 16 | sizeof(Arg) */
+    uint64_t source_hash;
+    uint64_t source_size;
+    uint64_t library_hash;
+    uint64_t call_count;
+    uint64_t arg_count;
+    uint64_t strings_size;    /* padded to 8 bytes, so the names start aligned */
+    uint64_t names_size;
+    uint64_t atom_count;
+} Script_Cache_Header;
+
+/* a 64-bit hash, a word at a time; good enough to key cache files */
+static uint64_t hash_bytes(uint64_t seed, const void *data, size_t size)
+{
+    const unsigned char *p = data;
+    uint64_t h = seed ^ (size*0x9e3779b97f4a7c15ull);
+    uint64_t w;
+
+    for (; size >= 8; p += 8, size -= 8) {
+        memcpy(&w, p, 8);
+        h ^= w*0xff51afd7ed558ccdull;
+        h = (h << 29 | h >> 35)*0xc4ceb9fe1a85ec53ull;
+    }
+    w = 0;
+    memcpy(&w, p, size);
+    h ^= w*0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+typedef struct Build_Id_Query {
+    ElfW(Addr) base;          /* of the library to look for */
+    uint64_t hash;
+    bool found;
+} Build_Id_Query;
+
+static int find_build_id(struct dl_phdr_info *info, size_t size, void *data)
+{
+    Build_Id_Query *query = data;
+
+    (void) size;
+    if (info->dlpi_addr != query->base) return 0;
+    for (int i = 0; i < info->dlpi_phnum; i++) {
+        const ElfW(Phdr) *phdr = &info->dlpi_phdr[i];
+        if (phdr->p_type != PT_NOTE) continue;
+
+        size_t align = phdr->p_align == 8 ? 8 : 4;
+        const char *p = (const char *) (info->dlpi_addr + phdr->p_vaddr);
+        const char *end = p + phdr->p_memsz;
+        while (end - p >= (ptrdiff_t) sizeof(ElfW(Nhdr))) {
+            const ElfW(Nhdr) *note = (const ElfW(Nhdr) *) p;
+            const char *name = p + sizeof(*note);
+            const char *desc = p + COOK_ALIGN_UP(sizeof(*note) + note->n_namesz, align);
+            if (note->n_type == NT_GNU_BUILD_ID && note->n_namesz == 4 && memcmp(name, "GNU", 4) == 0) {
+                query->hash = hash_bytes(0, desc, note->n_descsz);
+                query->found = true;
+                return 1;
+            }
+            p += COOK_ALIGN_UP((size_t) (desc - p) + note->n_descsz, align);
+        }
+    }
+    return 1;
+}
+
+/* identifies the build of lib by its GNU build-id, or by the size and time of its file */
+static uint64_t library_hash(void *lib, const char *path)
+{
+    struct link_map *map;
+    Build_Id_Query query = {0};
+    struct stat st;
+
+    if (dlinfo(lib, RTLD_DI_LINKMAP, &map) == 0) {
+        query.base = map->l_addr;
+        dl_iterate_phdr(find_build_id, &query);
+        if (query.found) return query.hash;
+    }
+    if (stat(path, &st) < 0) return 0;
+    uint64_t id[2] = {(uint64_t) st.st_size, (uint64_t) st.st_mtime};
+    return hash_bytes(1, id, sizeof(id));
+}
+
+/* the next count items of item_size in a cache file, or NULL if it's too short */
+static const void *cache_section(const char **p, size_t *left, uint64_t count, size_t item_size)
+{
+    const void *section = *p;
+
+    if (count > *left/item_size) return NULL;
+    *p += count*item_size;
+    *left -= count*item_size;
+    return section;
+}
+
+/* maps the cache file at cache_path into script if it matches expected */
+static bool load_script_cache(const char *cache_path, const Script_Cache_Header *expected, Script *script)
+{
+    File_Map cache;
+    if (!file_map(&cache, cache_path, COOK_FILE_MAP_WILLNEED)) return false;
+    if (cache.count < sizeof(Script_Cache_Header)) {
+        file_unmap(&cache);
+        return false;
+    }
+
+    const Script_Cache_Header *header = (const Script_Cache_Header *) cache.data;
+    const char *p = (const char *) (header + 1);
+    size_t left = cache.count - sizeof(*header);
+    const Call *calls = NULL;
+    const Arg *args = NULL;
+    const char *strings = NULL, *names = NULL;
+    bool ok = header->magic == expected->magic
+        && header->version == expected->version
+        && header->layout == expected->layout
+        && header->source_hash == expected->source_hash
+        && header->source_size == expected->source_size
+        && header->library_hash == expected->library_hash
+        && (calls = cache_section(&p, &left, header->call_count, sizeof(Call)))
+        && (args = cache_section(&p, &left, header->arg_count, sizeof(Arg)))
+        && (strings = cache_section(&p, &left, header->strings_size, 1))
+        && (names = cache_section(&p, &left, header->names_size, 1))
+        && left == 0
+        && (header->strings_size == 0 || strings[header->strings_size - 1] == '\0')
+        && (header->names_size == 0 || names[header->names_size - 1] == '\0');
+
+    /* the names go into the atom table, still empty before a script, so they get their atoms back */
+    const char *names_end = ok ? names + header->names_size : NULL;
+    for (uint64_t atom = 0; ok && atom < header->atom_count; atom++) {
+        const char *nul = names == names_end ? NULL : memchr(names, '\0', (size_t) (names_end - names));
+        ok = nul != NULL && stb_c_lexer_intern(&atoms, names, (int) (nul - names)) == (int) atom;
+        if (ok) names = nul + 1;
+    }
+    for (uint64_t i = 0; ok && i < header->call_count; i++) {
+        ok = calls[i].atom >= 0 && (uint64_t) calls[i].atom < header->atom_count
+            && calls[i].arg_count >= 0
+            && calls[i].first_arg <= header->arg_count
+            && (uint64_t) calls[i].arg_count <= header->arg_count - calls[i].first_arg;
+    }
+    for (uint64_t i = 0; ok && i < header->arg_count; i++) {
+        ok = args[i].kind == ARG_INT || args[i].kind == ARG_COLOR
+            || (args[i].kind == ARG_STRING && args[i].value.s < header->strings_size);
+    }
+
+    if (!ok) {
+        /* forget the names of a bad cache, or the one compiled in its place would keep them */
+        stb_c_lexer_atoms_init(&atoms, atom_memory, sizeof(atom_memory), MAX_ATOMS);
+        file_unmap(&cache);
+        return false;
+    }
+    script->calls = (Call *) calls;
+    script->call_count = header->call_count;
+    script->args = (Arg *) args;
+    script->arg_count = header->arg_count;
+    script->strings = (char *) strings;
+    script->strings_size = header->strings_size;
+    script->cache = cache;
+    return true;
+}
+
+/* writes script to cache_path through a temporary file, so readers never see half of it */
+static void save_script_cache(const char *cache_path, Script_Cache_Header header, const Script *script)
+{
+    static const char padding[8] = {0};
+    String_Builder names = NULL;
+    const char *temp_path = temp_strfmt("%s.%d.tmp", cache_path, (int) getpid());
+    bool ok;
+
+    for (int atom = 0; atom < atoms.count; atom++) {
+        int length;
+        const char *name = stb_c_lexer_atom_name(&atoms, atom, &length);
+        sb_append_parts(&names, name, (size_t) length + 1);
+    }
+    header.call_count = script->call_count;
+    header.arg_count = script->arg_count;
+    header.strings_size = COOK_ALIGN_UP(script->strings_size, 8);
+    header.names_size = vec_size(names);
+    header.atom_count = (uint64_t) atoms.count;
+
+    mkdir(SCRIPT_CACHE_DIR, 0755);
+    FILE *f = fopen(temp_path, "wb");
+    ok = f != NULL
+        && fwrite(&header, sizeof(header), 1, f) == 1
+        && fwrite(script->calls, sizeof(Call), script->call_count, f) == script->call_count
+        && fwrite(script->args, sizeof(Arg), script->arg_count, f) == script->arg_count
+        && fwrite(script->strings, 1, script->strings_size, f) == script->strings_size
+        && fwrite(padding, 1, header.strings_size - script->strings_size, f) == header.strings_size - script->strings_size
+        && fwrite(names, 1, vec_size(names), f) == vec_size(names);
+    if (f && fclose(f) != 0) ok = false;
+    if (ok && rename(temp_path, cache_path) < 0) ok = false;
+    if (!ok) {
+        fprintf(stderr, "WARNING: could not write %s\n", cache_path);
+        unlink(temp_path);
+    }
+    vec_free(names);
+}
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec*1e3 + (double)ts.tv_nsec/1e6;
+}
+
+static int run_script(void *raylib, const char *library, const char *path, int jobs, bool compile_only, bool use_cache, bool timed)
+{
+    Script script = {0};
+    Script_Cache_Header header = {0};
+    const char *cache_path = NULL;
+    File_Map source;
+    bool cached = false;
+    bool ok;
+
+    /* the chunks get lexed on several threads at once, so all of it is needed soon */
+    if (!file_map(&source, path, COOK_FILE_MAP_WILLNEED)) {
+        fprintf(stderr, "ERROR: could not read %s\n", path);
+        return 1;
+    }
+
+    double start = now_ms();
+    if (use_cache) {
+        header.magic = SCRIPT_CACHE_MAGIC;
+        header.version = SCRIPT_CACHE_VERSION;
+        header.layout = (uint32_t) (sizeof(Call) << 16 | sizeof(Arg));
+        header.source_hash = hash_bytes(0, source.data, source.count);
+        header.source_size = (uint64_t) source.count;
+        header.library_hash = library_hash(raylib, library);
+        uint64_t key = hash_bytes(header.source_hash, &header.library_hash, sizeof(header.library_hash));
+        cache_path = temp_strfmt(SCRIPT_CACHE_DIR"%016llx", (unsigned long long) key);
+        cached = load_script_cache(cache_path, &header, &script);
+    }
+    ok = cached || compile_script(path, source.data, source.count, jobs, &script);
+    double compiled = now_ms();
+    if (ok && use_cache && !cached) save_script_cache(cache_path, header, &script);
+    double saved = now_ms();
+    ok = ok && link_script(raylib, path, &script);
+    double linked = now_ms();
+    if (ok && !compile_only) execute_script(&script);
+    double executed = now_ms();
+
+    if (ok && (compile_only || timed)) {
+        fprintf(stderr, "%s: %zu calls from %.2f MB, %s in %.2f ms, linked in %.2f ms",
+                path, script.call_count, (double) source.count/1e6,
+                cached ? "loaded from the cache" : temp_strfmt("compiled on %d threads", jobs),
+                compiled - start, linked - saved);
+        if (!compile_only) {
+            fprintf(stderr, ", executed in %.2f ms (%.1f ns/call)", executed - linked,
+                    script.call_count ? (executed - linked)*1e6/(double) script.call_count : 0.0);
+        }
+        fprintf(stderr, "\n");
+    }
+
+    file_unmap(&source);
+    if (script.cache.count > 0) {
+        file_unmap(&script.cache);
+    } else {
+        free(script.calls);
+        free(script.args);
+        free(script.strings);
+    }
+    return ok ? 0 : 1;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [-j jobs] [-c] [-t] [-n] [-l library] [script]\n", program);
+    fprintf(stderr, "    without a script, read calls from stdin one line at a time\n");
+    fprintf(stderr, "    -j jobs    compile the script on this many threads (default: one per core)\n");
+    fprintf(stderr, "    -c         compile and link the script, report the timing, don't run it\n");
+    fprintf(stderr, "    -t         run the script and report the timing of every step\n");
+    fprintf(stderr, "    -n         neither read nor write the compiled script in "SCRIPT_CACHE_DIR"\n");
+    fprintf(stderr, "    -l library call into this library instead of "RAYLIB_PATH"\n");
+}
+
+int main(int argc, char **argv)
+{
+    void *raylib;             /* dll handle */
+    const char *program = argv[0];
+    const char *path = NULL;
+    const char *library = RAYLIB_PATH;
+    int jobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    bool compile_only = false;
+    bool use_cache = true;
+    bool timed = false;
+    int result;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            jobs = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "-c") == 0) {
+            compile_only = true;
+        } else if (strcmp(argv[i], "-t") == 0) {
+            timed = true;
+        } else if (strcmp(argv[i], "-n") == 0) {
+            use_cache = false;
+        } else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc) {
+            library = argv[++i];
+        } else if (argv[i][0] != '-' && !path) {
+            path = argv[i];
+        } else {
+            usage(program);
+            return 1;
+        }
+    }
+    if (jobs < 1) jobs = 1;
+
+    stb_c_lexer_atoms_init(&atoms, atom_memory, sizeof(atom_memory), MAX_ATOMS);
+
+    ffi_type_color.size = sizeof(Color);
+    ffi_type_color.alignment = 1;
+    ffi_type_color.type = FFI_TYPE_STRUCT;
+    ffi_type_color.elements = ffi_type_color_elements;
+    ffi_type_color.elements[0] = &ffi_type_uint8;
+    ffi_type_color.elements[1] = &ffi_type_uint8;
+    ffi_type_color.elements[2] = &ffi_type_uint8;
+    ffi_type_color.elements[3] = &ffi_type_uint8;
+    ffi_type_color.elements[4] = NULL;
+
+    raylib = dlopen(library, RTLD_NOW);
+    if (!raylib) {
+        fprintf(stderr, "ERROR: %s\n", dlerror());
+        return 1;
+    }
+
+    result = path ? run_script(raylib, library, path, jobs, compile_only, use_cache, timed) : repl(raylib);
+
+    vec_free(symbols);
+    dlclose(raylib);
+
+    return result;
+}
@@ -1,22 +1,982 @@
+#define BUILD_DIR "build/"
+
 #define NOB_IMPLEMENTATION
 #define NOB_STRIP_PREFIX
 #define NOB_EXPERIMENTAL_DELETE_OLD
+#define NOB_REBUILD_URSELF_OBJECT BUILD_DIR"nob.o" /* a rebuild compiles nob.c alone */
 #include "nob.h"
 
+#include <ctype.h>
+#include <sys/resource.h>
+
 Cmd cmd = {0};
 
+#define DEPS_DIR          BUILD_DIR"deps/"
+#define BUILD_DB          BUILD_DIR"nob.db"
+#define DEFAULT_CACHE_DIR BUILD_DIR"cache/"
+#define TRACE_FILE        BUILD_DIR"trace.json"
+
+/*
+ * build graph
+ *
+ * A target is an output, the command that compiles it and the inputs that
+ * decide what it contains. The command runs with -MMD -MF, so the compiler
+ * lists every source and header it read in a depfile in DEPS_DIR. The key
+ * of a target hashes its command and the path and contents of each of those
+ * inputs, and of any added with add_target_input(). BUILD_DB records the
+ * key every output was last built with, and a target is up to date while
+ * its key stays the same, whatever the times of its files say.
+ *
+ * Outputs also go into a content-addressed cache, $NOB_CACHE_DIR or
+ * DEFAULT_CACHE_DIR, as <key> and <key>.d for the depfile. A target whose
+ * key is in the cache is copied out of it instead of compiled, so build
+ * variants and worktrees that point NOB_CACHE_DIR at the same directory
+ * share their builds. A target without a depfile of its own borrows the
+ * one of the last build of the same command, <command hash>.cmd.d, to find
+ * its key. A link has no depfile: add_link_target() gives it the objects as
+ * its inputs. The targets of one build_targets() run in parallel, at most
+ * nob_nprocs() at a time, so a link goes in a build_targets() of its own
+ * after its objects.
+ */
+typedef struct {
+    const char *output;
+    Cmd cmd;
+    File_Paths extra_inputs;  /* what the depfile doesn't list, e.g. a profile */
+    String_Builder command;   /* cmd rendered */
+    uint64_t key;             /* 0 if it can't be known before compiling */
+    bool links;               /* all its inputs are extra_inputs */
+    bool compiled;
+} Target;
+
+typedef struct {
+    Target *items;
+    size_t count;
+    size_t capacity;
+} Targets;
+
+typedef struct {
+    const char *output;
+    uint64_t key;
+} Build_Record;
+
+typedef struct {
+    Build_Record *items;
+    size_t count;
+    size_t capacity;
+} Build_Db;
+
+static Targets targets = {0};
+static Build_Db build_db = {0};
+
+/* adds a target for output; append its command to the result before adding the next one */
+static Cmd *add_target(const char *output)
+{
+    Target target = {.output = output};
+    da_append(&targets, target);
+    return &targets.items[targets.count - 1].cmd;
+}
+
+/* makes path an input of the last target added, besides the ones of its depfile */
+static void add_target_input(const char *path)
+{
+    da_append(&targets.items[targets.count - 1].extra_inputs, path);
+}
+
+/* adds a target that links objects, each added with add_target_input() */
+static Cmd *add_link_target(const char *output)
+{
+    Cmd *cmd = add_target(output);
+    targets.items[targets.count - 1].links = true;
+    return cmd;
+}
+
+/* DEPS_DIR"build_bench_lex_sse2.d" for build/bench_lex_sse2 */
+static const char *deps_path(const char *output, const char *extension)
+{
+    char *path = temp_sprintf(DEPS_DIR"%s%s", output, extension);
+    for (char *p = path + strlen(DEPS_DIR); *p; p++) if (*p == '/') *p = '_';
+    return path;
+}
+
+static const char *cache_dir(void)
+{
+    const char *dir = getenv("NOB_CACHE_DIR");
+    return dir && *dir ? temp_sprintf("%s/", dir) : DEFAULT_CACHE_DIR;
+}
+
+#define HASH_SEED 0xcbf29ce484222325ull
+
+/* FNV-1a */
+static uint64_t hash_bytes(uint64_t h, const void *data, size_t size)
+{
+    const unsigned char *p = data;
+    for (size_t i = 0; i < size; i++) h = (h ^ p[i])*0x100000001b3ull;
+    return h;
+}
+
+/* the prerequisites of the rule "output: main.c cook.h \ ..." -MMD writes */
+static bool read_depfile(const char *path, File_Paths *inputs)
+{
+    File_Map depfile;
+    String_Builder word = {0};
+    if (!file_map(&depfile, path, 0)) return false;
+
+    const char *p = memchr(depfile.data, ':', depfile.count);
+    const char *end = depfile.data + depfile.count;
+    bool ok = p != NULL;
+    for (p = ok ? p + 1 : end; p <= end; p++) {
+        if (p < end && *p == '\\' && p + 1 < end && (p[1] == '\n' || p[1] == ' ')) {
+            if (p[1] == ' ') da_append(&word, ' '); /* an escaped space in a path */
+            p++;
+        } else if (p < end && !isspace((unsigned char) *p)) {
+            da_append(&word, *p);
+        } else if (word.count > 0) {
+            da_append(inputs, temp_sprintf("%.*s", (int) word.count, word.items));
+            word.count = 0;
+        }
+    }
+    file_unmap(&depfile);
+    sb_free(word);
+    return ok;
+}
+
+/* hashes the path and the contents of every input into h; false if one is gone */
+static bool hash_inputs(uint64_t *h, const File_Paths *inputs)
+{
+    File_Map file;
+    bool ok = true;
+
+    da_foreach(const char*, input, inputs) {
+        ok = file_exists(*input) == 1 && file_map(&file, *input, NOB_FILE_MAP_SEQUENTIAL);
+        if (!ok) break;
+        *h = hash_bytes(*h, *input, strlen(*input) + 1);
+        *h = hash_bytes(*h, file.data, file.count);
+        file_unmap(&file);
+    }
+    return ok;
+}
+
+/* the key of t with the inputs listed in depfile (none for a link), or 0 */
+static uint64_t target_key(const Target *t, const char *depfile)
+{
+    File_Paths inputs = {0};
+    uint64_t key = hash_bytes(HASH_SEED, t->command.items, t->command.count);
+    bool ok = (t->links || (file_exists(depfile) == 1 && read_depfile(depfile, &inputs)))
+        && hash_inputs(&key, &inputs)
+        && hash_inputs(&key, &t->extra_inputs);
+    da_free(inputs);
+    return ok ? key : 0;
+}
+
+/* the depfile of the last build of the command of t, in cache */
+static const char *manifest_path(const Target *t, const char *cache)
+{
+    uint64_t h = hash_bytes(HASH_SEED, t->command.items, t->command.count);
+    return temp_sprintf("%s%016llx.cmd.d", cache, (unsigned long long) h);
+}
+
+static bool load_build_db(void)
+{
+    File_Map db;
+
+    build_db.count = 0;
+    if (file_exists(BUILD_DB) != 1) return true;
+    if (!file_map(&db, BUILD_DB, 0)) return false;
+
+    String_View content = sv_from_parts(db.data, db.count);
+    while (content.count > 0) {
+        String_View line = sv_chop_by_delim(&content, '\n');
+        String_View key = sv_chop_by_delim(&line, ' ');
+        Build_Record record = {
+            .output = strndup(line.data, line.count),
+            .key = strtoull(temp_sv_to_cstr(key), NULL, 16),
+        };
+        if (line.count > 0) da_append(&build_db, record);
+    }
+    file_unmap(&db);
+    return true;
+}
+
+static bool save_build_db(void)
+{
+    String_Builder sb = {0};
+    da_foreach(Build_Record, record, &build_db) {
+        sb_appendf(&sb, "%016llx %s\n", (unsigned long long) record->key, record->output);
+    }
+    bool ok = write_entire_file(BUILD_DB".tmp", sb.items, sb.count) && rename(BUILD_DB".tmp", BUILD_DB) == 0;
+    sb_free(sb);
+    return ok;
+}
+
+static Build_Record *find_record(const char *output)
+{
+    da_foreach(Build_Record, record, &build_db) {
+        if (strcmp(record->output, output) == 0) return record;
+    }
+    return NULL;
+}
+
+static void set_record(const char *output, uint64_t key)
+{
+    Build_Record *record = find_record(output);
+    if (record) {
+        record->key = key;
+    } else {
+        Build_Record new_record = {strdup(output), key};
+        da_append(&build_db, new_record);
+    }
+}
+
+/* copies src to dst through a temporary file, so dst is never half written, nor busy if it runs */
+static bool copy_atomically(const char *src, const char *dst)
+{
+    const char *tmp = temp_sprintf("%s.%d.tmp", dst, (int) getpid());
+    if (!copy_file(src, tmp)) return false;
+    if (rename(tmp, dst) < 0) {
+        nob_log(ERROR, "could not rename %s to %s: %s", tmp, dst, strerror(errno));
+        delete_file(tmp);
+        return false;
+    }
+    return true;
+}
+
+/* records a target that compiled and puts it into the cache */
+static bool store_target(Target *t, const char *cache)
+{
+    const char *depfile = deps_path(t->output, ".d");
+    t->key = target_key(t, depfile);
+    if (!t->key) return true; /* an input went away while it compiled, build it again next time */
+
+    const char *object = temp_sprintf("%s%016llx", cache, (unsigned long long) t->key);
+    set_record(t->output, t->key);
+    if (t->links) return copy_atomically(t->output, object);
+    return copy_atomically(t->output, object)
+        && copy_atomically(depfile, temp_sprintf("%s.d", object))
+        && copy_atomically(depfile, manifest_path(t, cache));
+}
+
+/* builds the targets that are out of date and empties the graph */
+static bool build_targets(void)
+{
+    Procs procs = {0};
+    const char *cache = cache_dir();
+    bool ok = mkdir_if_not_exists(BUILD_DIR) && mkdir_if_not_exists(DEPS_DIR) && mkdir_if_not_exists(cache)
+        && load_build_db();
+
+    da_foreach(Target, t, &targets) {
+        if (!ok) break;
+        const char *depfile = deps_path(t->output, ".d");
+        cmd_render(t->cmd, &t->command);
+        t->key = target_key(t, file_exists(depfile) == 1 ? depfile : manifest_path(t, cache));
+
+        Build_Record *record = find_record(t->output);
+        if (t->key && record && record->key == t->key && file_exists(t->output) == 1) {
+            nob_log(INFO, "%s is up to date", t->output);
+            continue;
+        }
+        const char *object = temp_sprintf("%s%016llx", cache, (unsigned long long) t->key);
+        if (t->key && file_exists(object) == 1) {
+            ok = copy_atomically(object, t->output)
+                && (t->links || copy_atomically(temp_sprintf("%s.d", object), depfile));
+            if (ok) set_record(t->output, t->key);
+            continue;
+        }
+
+        if (!t->links) cmd_append(&t->cmd, "-MMD", "-MF", depfile);
+        t->compiled = true;
+        ok = cmd_run(&t->cmd, .async = &procs, .max_procs = (size_t) nprocs());
+    }
+    if (!procs_flush(&procs)) ok = false;
+
+    /* only once every command succeeded, so a failed one runs again next time */
+    da_foreach(Target, t, &targets) {
+        if (ok && t->compiled) ok = store_target(t, cache);
+        cmd_free(t->cmd);
+        sb_free(t->command);
+        da_free(t->extra_inputs);
+    }
+    if (!save_build_db()) ok = false;
+    targets.count = 0;
+    da_free(procs);
+    return ok;
+}
+
+#define PGO_DIR         BUILD_DIR"pgo/"
+#define PGO_PROFILE_DIR PGO_DIR"profile/"
+
+typedef enum {
+    PROFILE_DEBUG,
+    PROFILE_RELEASE,
+    PROFILE_PGO_GENERATE,     /* release, instrumented to write PGO_PROFILE_DIR */
+    PROFILE_PGO_USE,          /* release, optimized with the profile in PGO_PROFILE_DIR */
+} Build_Profile;
+
+#define OBJ_DIR BUILD_DIR"obj/"
+
+/* compiles headers.c and main.c into objects of their own, so that an edit
+ * to main.c compiles main.c alone before the link */
+static bool build_main_debug(void)
+{
+    static const char *sources[] = {"headers.c", "main.c"};
+    const char *objects[ARRAY_LEN(sources)];
+    if (!mkdir_if_not_exists(BUILD_DIR) || !mkdir_if_not_exists(OBJ_DIR)) return false;
+
+    for (size_t i = 0; i < ARRAY_LEN(sources); i++) {
+        objects[i] = temp_sprintf(OBJ_DIR"%.*s.o", (int) strlen(sources[i]) - 2, sources[i]);
+        Cmd *compile = add_target(objects[i]);
+        cmd_append(compile, "cc", "-Wall", "-Wextra", "-Wno-unused-function", "-ggdb");
+        cmd_append(compile, "-c", "-o", objects[i], sources[i]);
+    }
+    if (!build_targets()) return false;
+
+    Cmd *link = add_link_target("main");
+    cmd_append(link, "cc", "-o", "main");
+    for (size_t i = 0; i < ARRAY_LEN(objects); i++) {
+        cmd_append(link, objects[i]);
+        add_target_input(objects[i]);
+    }
+    cmd_append(link, "-lffi", "-pthread");
+    return build_targets();
+}
+
+static bool build_main(Build_Profile profile, bool native)
+{
+    if (profile == PROFILE_DEBUG) return build_main_debug();
+
+    /* one command, for LTO and the profile to see both files */
+    Cmd *build = add_target("main");
+    cmd_append(build, "cc");
+    cmd_append(build, "-Wall", "-Wextra", "-Wno-unused-function");
+    cmd_append(build, "-O3", "-flto=auto");
+    if (native) cmd_append(build, "-march=native");
+    /* the compiler threads update the counters concurrently */
+    if (profile == PROFILE_PGO_GENERATE) cmd_append(build, "-fprofile-generate="PGO_PROFILE_DIR, "-fprofile-update=atomic");
+    if (profile == PROFILE_PGO_USE) cmd_append(build, "-fprofile-use="PGO_PROFILE_DIR, "-fprofile-partial-training", "-Wno-missing-profile");
+    cmd_append(build, "-o", "main", "main.c", "headers.c");
+    cmd_append(build, "-lffi", "-pthread");
+    if (profile == PROFILE_PGO_USE) {
+        /* the profile decides the code as much as the sources do */
+        File_Paths profile_files = {0};
+        if (!read_entire_dir(PGO_PROFILE_DIR, &profile_files)) return false;
+        da_foreach(const char*, file, &profile_files) {
+            if ((*file)[0] != '.') add_target_input(temp_sprintf(PGO_PROFILE_DIR"%s", *file));
+        }
+        da_free(profile_files);
+    }
+
+    return build_targets();
+}
+
+static bool bench_cook(void)
+{
+    Cmd *bench = add_target(BUILD_DIR"bench_cook");
+    cmd_append(bench, "cc");
+    cmd_append(bench, "-Wall", "-Wextra", "-Wno-unused-function");
+    cmd_append(bench, "-O2");
+    cmd_append(bench, "-o", BUILD_DIR"bench_cook", "bench/cook.c");
+    if (!build_targets()) return false;
+
+    cmd_append(&cmd, BUILD_DIR"bench_cook");
+    return cmd_run(&cmd);
+}
+
+/* cook.hpp has no user in the tree yet, so this is what keeps it compiling and honest */
+static bool test_cook(void)
+{
+    Cmd *test = add_target(BUILD_DIR"test_cook");
+    cmd_append(test, "c++", "-std=c++17");
+    cmd_append(test, "-Wall", "-Wextra", "-Wno-unused-function");
+    cmd_append(test, "-ggdb", "-fsanitize=address,undefined");
+    cmd_append(test, "-o", BUILD_DIR"test_cook", "test/cook.cpp");
+    if (!build_targets()) return false;
+
+    cmd_append(&cmd, BUILD_DIR"test_cook");
+    return cmd_run(&cmd);
+}
+
+typedef struct {
+    const char *name;
+    const char *flags[2];
+    bool repl_only;           /* lexes the REPL grammar, not C */
+} Lex_Variant;
+
+static Lex_Variant lex_variants[] = {
+    {"scalar",  {"-DSTB_C_LEX_USE_SIMD=N"},                false},
+    {"sse2",    {0},                                      false},
+    {"avx2",    {"-mavx2", "-DSTB_C_LEX_SIMD_AVX2"},      false},
+    {"sse2-zc", {"-DSTB_C_LEX_ZERO_COPY=Y"},              false},
+    {"strtod",  {"-DSTB_C_LEX_EXACT_NUMBERS=N"},          false},
+    {"atoms",   {"-DLEX_ATOMS"},                          false},
+    {"lines",   {"-DLEX_LINES"},                          false},
+    {"repl",    {"-DSTB_C_LEXER_REPL_PROFILE"},           true},
+};
+
+#define CORPUS_DIR BUILD_DIR"corpus/"
+
+/* int-heavy: what a recorded drawing session looks like */
+static void generate_draw(String_Builder *sb)
+{
+    for (int i = 0; i < 1024*8; i++) {
+        sb_appendf(sb, "BeginDrawing\n");
+        sb_appendf(sb, "ClearBackground @ 245 245 245 255\n");
+        sb_appendf(sb, "DrawRectangle %d %d 0x%x 48 @ 230 41 55 255   # marker\n", i%800, i%600, 16 + i%64);
+        sb_appendf(sb, "DrawText \"frame %d\" 12 12 20 @ 0 0 0 255\n", i);
+        sb_appendf(sb, "DrawCircle 400 300 %d @ 0 121 241 255\n", i%50);
+        sb_appendf(sb, "EndDrawing\n");
+    }
+}
+
+/* string-heavy: credits, titles and log lines, some with escapes */
+static void generate_text(String_Builder *sb)
+{
+    for (int i = 0; i < 1024*4; i++) {
+        sb_appendf(sb, "SetWindowTitle \"Chapter %d: The quick brown fox jumps over the lazy dog\"\n", i);
+        sb_appendf(sb, "DrawText \"Line %d of the credits, in alphabetical order by family name\" 20 %d 18 @ 80 80 80 255\n", i, i%720);
+        sb_appendf(sb, "TraceLog 3 \"loaded \\\"level_%03d.map\\\" in\\t%d ms\\n\"\n", i%1000, i%97);
+        sb_appendf(sb, "DrawText \"%s\" 20 40 10 @ 0 0 0 255\n", i%2 ? "Press [SPACE] to continue" : "Press [ESC] to quit, or any other key to keep reading");
+    }
+}
+
+/* comment-heavy C: long block comments, line comments and a little code */
+static void generate_comments(String_Builder *sb)
+{
+    for (int i = 0; i < 1024*2; i++) {
+        sb_appendf(sb, "/*\n * helper_%d\n *\n", i);
+        for (int k = 0; k < 12; k++) {
+            sb_appendf(sb, " * Paragraph %d of the notes for this helper. It explains what the code below does,\n", k);
+        }
+        sb_appendf(sb, " */\n");
+        sb_appendf(sb, "// keep in sync with helper_%d\n", i + 1);
+        sb_appendf(sb, "static int helper_%d(int x) { return x*%d + 1; } // the only line of code\n\n", i, i%13);
+    }
+}
+
+typedef struct {
+    const char *name;
+    const char *path;
+    void (*generate)(String_Builder *sb); /* NULL for a file of the repository */
+    bool repl_grammar;
+} Lex_Corpus;
+
+static Lex_Corpus lex_corpora[] = {
+    {"draw",     CORPUS_DIR"draw.txt",     generate_draw,     true},
+    {"text",     CORPUS_DIR"text.txt",     generate_text,     true},
+    {"comments", CORPUS_DIR"comments.h",   generate_comments, false},
+    {"raylib",   "raylib/include/raylib.h", NULL,             false},
+};
+
+static bool write_generated(const char *path, void (*generate)(String_Builder *sb))
+{
+    String_Builder sb = {0};
+    generate(&sb);
+    bool ok = write_entire_file(path, sb.items, sb.count);
+    sb_free(sb);
+    return ok;
+}
+
+/* ./nob bench-lex [-r rounds] [-p cpu]: every variant over every corpus it can lex */
+static bool bench_lex(int argc, char **argv)
+{
+    const char *rounds = "5";
+    const char *cpu = "0";
+    const char *results = BUILD_DIR"bench-lex.jsonl";
+
+    while (argc > 0) {
+        const char *flag = shift(argv, argc);
+        if (argc > 0 && strcmp(flag, "-r") == 0) rounds = shift(argv, argc);
+        else if (argc > 0 && strcmp(flag, "-p") == 0) cpu = shift(argv, argc);
+        else {
+            nob_log(ERROR, "usage: bench-lex [-r rounds] [-p cpu]");
+            return false;
+        }
+    }
+
+    for (size_t i = 0; i < ARRAY_LEN(lex_variants); i++) {
+        Lex_Variant *v = &lex_variants[i];
+        const char *output = temp_sprintf(BUILD_DIR"bench_lex_%s", v->name);
+
+        Cmd *bench = add_target(output);
+        cmd_append(bench, "cc");
+        cmd_append(bench, "-Wall", "-Wextra", "-Wno-unused-function");
+        cmd_append(bench, "-O2");
+        cmd_append(bench, temp_sprintf("-DVARIANT=\"%s\"", v->name));
+        for (size_t j = 0; j < ARRAY_LEN(v->flags) && v->flags[j]; j++) cmd_append(bench, v->flags[j]);
+        cmd_append(bench, "-o", output, "bench/lex.c");
+    }
+    if (!build_targets()) return false;
+    if (!mkdir_if_not_exists(CORPUS_DIR)) return false;
+
+    for (size_t i = 0; i < ARRAY_LEN(lex_corpora); i++) {
+        if (lex_corpora[i].generate && !write_generated(lex_corpora[i].path, lex_corpora[i].generate)) return false;
+    }
+
+    if (file_exists(results) == 1 && !delete_file(results)) return false;
+    for (size_t i = 0; i < ARRAY_LEN(lex_corpora); i++) {
+        Lex_Corpus *corpus = &lex_corpora[i];
+        for (size_t j = 0; j < ARRAY_LEN(lex_variants); j++) {
+            if (lex_variants[j].repl_only && !corpus->repl_grammar) continue;
+            cmd_append(&cmd, temp_sprintf(BUILD_DIR"bench_lex_%s", lex_variants[j].name));
+            cmd_append(&cmd, "-r", rounds, "-p", cpu, "-n", corpus->name, "-o", results, corpus->path);
+            if (!cmd_run(&cmd)) return false;
+        }
+    }
+
+    nob_log(INFO, "results in %s", results);
+    return true;
+}
+
+/* dispatch: a million short calls, so the time goes to calling through libffi */
+static void generate_dispatch(String_Builder *sb)
+{
+    sb_appendf(sb, "InitWindow 800 600 \"dispatch\"\n");
+    for (int i = 0; i < 1024*48; i++) {
+        sb_appendf(sb, "BeginDrawing\nClearBackground @ 0 0 0 255\n");
+        for (int k = 0; k < 18; k++) sb_appendf(sb, "DrawPixel %d %d @ 255 255 255 255\n", (i + k*37)%800, (i*7 + k)%600);
+        sb_appendf(sb, "EndDrawing\n");
+    }
+    sb_appendf(sb, "CloseWindow\n");
+}
+
+/* replay: what a recorded session of a small game looks like */
+static void generate_replay(String_Builder *sb)
+{
+    sb_appendf(sb, "# recorded session\nInitWindow 800 450 \"replay\"\nSetTargetFPS 60\n");
+    for (int i = 0; i < 1024*24; i++) {
+        sb_appendf(sb, "BeginDrawing\n");
+        sb_appendf(sb, "ClearBackground @ 245 245 245 255\n");
+        sb_appendf(sb, "DrawRectangle %d %d 0x%x 48 @ 230 41 55 255   # player\n", i%800, 300 + i%20, 16 + i%64);
+        sb_appendf(sb, "DrawRectangleLines 10 10 %d 20 @ 0 0 0 255\n", 100 + i%200);
+        sb_appendf(sb, "DrawLine 0 400 800 400 @ 130 130 130 255\n");
+        sb_appendf(sb, "DrawText \"score %d\" 12 12 20 @ 0 0 0 255\n", i*10);
+        if (i%60 == 0) sb_appendf(sb, "SetWindowTitle \"replay - second %d\"\n", i/60);
+        sb_appendf(sb, "EndDrawing\n");
+    }
+    sb_appendf(sb, "CloseWindow\n");
+}
+
+typedef struct {
+    const char *name;
+    const char *path;
+    void (*generate)(String_Builder *sb);
+    double compile_ms, execute_ms; /* best of the runs */
+} Pgo_Workload;
+
+static Pgo_Workload pgo_workloads[] = {
+    {"dispatch", PGO_DIR"dispatch.txt", generate_dispatch, 0, 0},
+    {"replay",   PGO_DIR"replay.txt",   generate_replay,   0, 0},
+};
+
+#define PGO_RUNS 3
+
+/* runs the workload on ./main against the headless raylib; with timing, keeps the best of PGO_RUNS */
+static bool run_workload(Pgo_Workload *w, bool timing)
+{
+    const char *log = PGO_DIR"main.log";
+    String_Builder sb = {0};
+    double compile_ms, execute_ms;
+    bool ok = true;
+
+    w->compile_ms = w->execute_ms = 0;
+    for (int run = 0; ok && run < (timing ? PGO_RUNS : 1); run++) {
+        cmd_append(&cmd, "./main", "-t", "-n", "-l", BUILD_DIR"libheadless.so", w->path);
+        sb.count = 0;
+        ok = cmd_run(&cmd, .stderr_path = log) && read_entire_file(log, &sb);
+        if (!ok) break;
+        sb_append_null(&sb);
+
+        const char *times = strstr(sb.items, " threads in ");
+        if (!times || sscanf(times, " threads in %lf ms, linked in %*f ms, executed in %lf ms", &compile_ms, &execute_ms) != 2) {
+            nob_log(ERROR, "could not find the timing of %s in %s", w->path, log);
+            ok = false;
+            break;
+        }
+        if (run == 0 || compile_ms < w->compile_ms) w->compile_ms = compile_ms;
+        if (run == 0 || execute_ms < w->execute_ms) w->execute_ms = execute_ms;
+    }
+    sb_free(sb);
+    return ok;
+}
+
+/* the counters of an instrumented run add up with the ones already on disk */
+static bool clear_profile(void)
+{
+    File_Paths children = {0};
+    bool ok = mkdir_if_not_exists(PGO_PROFILE_DIR) && read_entire_dir(PGO_PROFILE_DIR, &children);
+    da_foreach(const char*, child, &children) {
+        if (ok && strcmp(*child, ".") != 0 && strcmp(*child, "..") != 0) {
+            ok = delete_file(temp_sprintf(PGO_PROFILE_DIR"%s", *child));
+        }
+    }
+    da_free(children);
+    return ok;
+}
+
+/* ./nob pgo [--native]: release build, trained on the workloads, compared before and after */
+static bool pgo(bool native)
+{
+    double before[ARRAY_LEN(pgo_workloads)][2];
+
+    Cmd *headless = add_target(BUILD_DIR"libheadless.so");
+    cmd_append(headless, "cc", "-O2", "-shared", "-fPIC", "-o", BUILD_DIR"libheadless.so", "bench/headless.c");
+    if (!build_targets()) return false;
+    if (!mkdir_if_not_exists(PGO_DIR)) return false;
+    for (size_t i = 0; i < ARRAY_LEN(pgo_workloads); i++) {
+        if (!write_generated(pgo_workloads[i].path, pgo_workloads[i].generate)) return false;
+    }
+
+    nob_log(INFO, "pgo: timing the release build");
+    if (!build_main(PROFILE_RELEASE, native)) return false;
+    for (size_t i = 0; i < ARRAY_LEN(pgo_workloads); i++) {
+        if (!run_workload(&pgo_workloads[i], true)) return false;
+        before[i][0] = pgo_workloads[i].compile_ms;
+        before[i][1] = pgo_workloads[i].execute_ms;
+    }
+
+    nob_log(INFO, "pgo: training the instrumented build");
+    if (!clear_profile()) return false;
+    if (!build_main(PROFILE_PGO_GENERATE, native)) return false;
+    for (size_t i = 0; i < ARRAY_LEN(pgo_workloads); i++) {
+        if (!run_workload(&pgo_workloads[i], false)) return false;
+    }
+
+    nob_log(INFO, "pgo: timing the build optimized with the profile");
+    if (!build_main(PROFILE_PGO_USE, native)) return false;
+    for (size_t i = 0; i < ARRAY_LEN(pgo_workloads); i++) {
+        if (!run_workload(&pgo_workloads[i], true)) return false;
+    }
+
+    for (size_t i = 0; i < ARRAY_LEN(pgo_workloads); i++) {
+        Pgo_Workload *w = &pgo_workloads[i];
+        nob_log(INFO, "pgo: %-8s compile %8.2f -> %8.2f ms (%+5.1f%%), execute %8.2f -> %8.2f ms (%+5.1f%%)",
+                w->name, before[i][0], w->compile_ms, 100*(w->compile_ms/before[i][0] - 1),
+                before[i][1], w->execute_ms, 100*(w->execute_ms/before[i][1] - 1));
+    }
+    return true;
+}
+
+#define SPAWN_DIR    BUILD_DIR"spawn/"
+#define SPAWN_ROUNDS 3
+
+static double now_ms(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec*1e3 + ts.tv_nsec/1e6;
+}
+
+/* user and system time of nob itself, without its children */
+static double self_cpu_ms(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)*1e3 + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec)/1e3;
+}
+
+/* the wait nob.h used to do for a free slot: waitpid(WNOHANG) on each process, a millisecond of sleep after each one still running */
+static bool wait_any_polling(Procs *procs)
+{
+    struct timespec duration = {.tv_sec = 0, .tv_nsec = 1000*1000};
+    for (;;) {
+        for (size_t i = 0; i < procs->count; i++) {
+            int wstatus = 0;
+            pid_t pid = waitpid(procs->items[i], &wstatus, WNOHANG);
+            if (pid == 0) {
+                nanosleep(&duration, NULL);
+                continue;
+            }
+            da_remove_unordered(procs, i);
+            return pid > 0 && WIFEXITED(wstatus) && WEXITSTATUS(wstatus) == 0;
+        }
+    }
+}
+
+/* compiles jobs copies of a one-line file, slots at a time; returns the wall and nob's own cpu time */
+static bool run_spawn_jobs(int jobs, int slots, bool polling, double *wall_ms, double *cpu_ms)
+{
+    Procs procs = {0};
+    bool ok = true;
+    double start = now_ms(), start_cpu = self_cpu_ms();
+
+    for (int i = 0; ok && i < jobs; i++) {
+        while (ok && polling && procs.count >= (size_t) slots) ok = wait_any_polling(&procs);
+        cmd_append(&cmd, "cc", "-c", "-o", temp_sprintf(SPAWN_DIR"job%d.o", i), SPAWN_DIR"job.c");
+        ok = ok && cmd_run(&cmd, .async = &procs, .max_procs = (size_t) slots);
+        cmd.count = 0;
+    }
+    if (!procs_flush(&procs)) ok = false;
+
+    *wall_ms = now_ms() - start;
+    *cpu_ms = self_cpu_ms() - start_cpu;
+    da_free(procs);
+    return ok;
+}
+
+/* what nob.h did before posix_spawn(): fork() all of nob, then exec */
+static pid_t launch_forking(const char *program)
+{
+    pid_t pid = fork();
+    if (pid == 0) {
+        execlp(program, program, (char *) NULL);
+        _exit(127);
+    }
+    return pid;
+}
+
+/* the average time to start `true`, with nob.h and with fork(), until the pid is known */
+static bool time_launches(int launches, double *spawn_us, double *fork_us)
+{
+    Procs procs = {0};
+    bool ok = true;
+
+    *spawn_us = *fork_us = 0;
+    for (int i = 0; ok && i < launches; i++) {
+        cmd_append(&cmd, "true");
+        double start = now_ms();
+        ok = cmd_run(&cmd, .async = &procs);
+        *spawn_us += (now_ms() - start)*1e3/launches;
+        ok = procs_flush(&procs) && ok;
+
+        start = now_ms();
+        pid_t pid = launch_forking("true");
+        *fork_us += (now_ms() - start)*1e3/launches;
+        ok = ok && pid > 0 && waitpid(pid, NULL, 0) == pid;
+    }
+    da_free(procs);
+    return ok;
+}
+
+/*
+ * ./nob bench-spawn [-n jobs] [-j slots] [-m MB]: many short compiler jobs,
+ * waited for the way nob.h used to and with procs_wait_any(), the best of
+ * SPAWN_ROUNDS each, alternating, with the cpu time nob itself spent waking
+ * up. Then the time to start a command with posix_spawn() and with fork(),
+ * as nob is now and once it holds MB megabytes more.
+ */
+static bool bench_spawn(int argc, char **argv)
+{
+    int jobs = 200;
+    int slots = nprocs() + 1;
+    int megabytes = 1024;
+    double best[2][2] = {0};
+
+    while (argc > 0) {
+        const char *flag = shift(argv, argc);
+        if (argc > 0 && strcmp(flag, "-n") == 0) jobs = atoi(shift(argv, argc));
+        else if (argc > 0 && strcmp(flag, "-j") == 0) slots = atoi(shift(argv, argc));
+        else if (argc > 0 && strcmp(flag, "-m") == 0) megabytes = atoi(shift(argv, argc));
+        else jobs = 0;
+        if (jobs < 1 || slots < 1 || megabytes < 0) {
+            nob_log(ERROR, "usage: bench-spawn [-n jobs] [-j slots] [-m MB]");
+            return false;
+        }
+    }
+
+    const char *source = "int job(void) { return 0; }\n";
+    if (!mkdir_if_not_exists(BUILD_DIR) || !mkdir_if_not_exists(SPAWN_DIR)) return false;
+    if (!write_entire_file(SPAWN_DIR"job.c", source, strlen(source))) return false;
+
+    nob_log(INFO, "bench-spawn: %d jobs, %d at a time", jobs, slots);
+    Log_Level level = minimal_log_level;
+    minimal_log_level = WARNING;
+    bool ok = true;
+    for (int round = 0; ok && round < SPAWN_ROUNDS; round++) {
+        for (int polling = 0; ok && polling < 2; polling++) {
+            double wall_ms, cpu_ms;
+            ok = run_spawn_jobs(jobs, slots, polling, &wall_ms, &cpu_ms);
+            if (round == 0 || wall_ms < best[polling][0]) best[polling][0] = wall_ms;
+            if (round == 0 || cpu_ms < best[polling][1]) best[polling][1] = cpu_ms;
+        }
+    }
+    minimal_log_level = level;
+    if (!ok) return false;
+
+    const char *names[2] = {"wait-any", "polling"};
+    for (int polling = 0; polling < 2; polling++) {
+        nob_log(INFO, "bench-spawn: %-8s %8.2f ms, %6.0f jobs/s, %6.2f ms of cpu in nob",
+                names[polling], best[polling][0], jobs/(best[polling][0]/1e3), best[polling][1]);
+    }
+
+    double launch_us[2][2];
+    char *ballast = NULL;
+    minimal_log_level = WARNING;
+    for (int large = 0; ok && large < 2; large++) {
+        if (large) {
+            /* touched, so every page is mapped and fork() has to copy its entry */
+            ballast = malloc((size_t) megabytes*1024*1024);
+            if (ballast) memset(ballast, 1, (size_t) megabytes*1024*1024);
+        }
+        ok = time_launches(jobs, &launch_us[large][0], &launch_us[large][1]);
+    }
+    free(ballast);
+    minimal_log_level = level;
+    if (!ok) return false;
+
+    for (int large = 0; large < 2; large++) {
+        nob_log(INFO, "bench-spawn: start with %4d MB more: posix_spawn %8.1f us, fork %8.1f us",
+                large ? megabytes : 0, launch_us[large][0], launch_us[large][1]);
+    }
+    return true;
+}
+
+#define DIST_DIR BUILD_DIR"dist/"
+
+/* ./nob dist [--native]: a release build of main staged with raylib in DIST_DIR, to run from there */
+static bool dist(bool native)
+{
+    if (!build_main(PROFILE_RELEASE, native)) return false;
+    return mkdir_if_not_exists(BUILD_DIR)
+        && mkdir_if_not_exists(DIST_DIR)
+        && copy_file("main", DIST_DIR"main")
+        && copy_file("README.md", DIST_DIR"README.md")
+        && copy_directory_recursively("raylib", DIST_DIR"raylib");
+}
+
+#define COPY_DIR    BUILD_DIR"copy/"
+#define COPY_ROUNDS 3
+
+/* what nob.h did before: one file after another, through a 32 KB buffer */
+static bool copy_file_buffered(const char *src, const char *dst, size_t *bytes)
+{
+    static char buf[32*1024];
+    struct stat st;
+    int in = open(src, O_RDONLY);
+    if (in < 0 || fstat(in, &st) < 0) return false;
+    int out = open(dst, O_CREAT | O_TRUNC | O_WRONLY, st.st_mode);
+    bool ok = out >= 0;
+    for (ssize_t n; ok && (n = read(in, buf, sizeof(buf))) != 0;) {
+        ok = n > 0 && write(out, buf, (size_t) n) == n;
+        *bytes += (size_t) n;
+    }
+    close(in);
+    if (out >= 0) close(out);
+    return ok;
+}
+
+static bool copy_tree_buffered(const char *src, const char *dst, size_t *bytes)
+{
+    File_Paths children = {0};
+    bool ok = true;
+
+    switch (get_file_type(src)) {
+    case FILE_REGULAR: return copy_file_buffered(src, dst, bytes);
+    case FILE_SYMLINK: return true;
+    case FILE_DIRECTORY: break;
+    default: return false;
+    }
+    ok = mkdir_if_not_exists(dst) && read_entire_dir(src, &children);
+    da_foreach(const char*, child, &children) {
+        if (!ok || strcmp(*child, ".") == 0 || strcmp(*child, "..") == 0) continue;
+        ok = copy_tree_buffered(temp_sprintf("%s/%s", src, *child), temp_sprintf("%s/%s", dst, *child), bytes);
+    }
+    da_free(children);
+    return ok;
+}
+
+static bool remove_tree(const char *path)
+{
+    cmd_append(&cmd, "rm", "-rf", path);
+    return cmd_run(&cmd);
+}
+
+/* a staging tree: the raylib tree, a few large assets and many small ones */
+static bool make_copy_source(const char *src)
+{
+    String_Builder sb = {0};
+    bool ok = remove_tree(src) && mkdir_if_not_exists(src) && copy_directory_recursively("raylib", temp_sprintf("%s/raylib", src))
+        && mkdir_if_not_exists(temp_sprintf("%s/large", src)) && mkdir_if_not_exists(temp_sprintf("%s/small", src));
+
+    for (size_t i = 0; i < 16*1024*1024; i++) da_append(&sb, (char) (i*2654435761u >> 24));
+    for (int i = 0; ok && i < 4; i++) ok = write_entire_file(temp_sprintf("%s/large/%d.bin", src, i), sb.items, sb.count);
+    for (int i = 0; ok && i < 512; i++) ok = write_entire_file(temp_sprintf("%s/small/%d.bin", src, i), sb.items + i, 16*1024);
+    sb_free(sb);
+    return ok;
+}
+
+/*
+ * ./nob bench-copy: copies a staging tree the way nob.h used to and with
+ * copy_directory_recursively(), the best of COPY_ROUNDS each, alternating.
+ * Both read from the page cache, so it's the cost of moving the bytes.
+ */
+static bool bench_copy(void)
+{
+    const char *src = COPY_DIR"src", *dst = COPY_DIR"dst";
+    double best[2] = {0};
+    size_t bytes = 0;
+
+    if (!mkdir_if_not_exists(BUILD_DIR) || !mkdir_if_not_exists(COPY_DIR)) return false;
+    Log_Level level = minimal_log_level;
+    minimal_log_level = WARNING;
+    bool ok = make_copy_source(src);
+
+    for (int round = 0; ok && round < COPY_ROUNDS; round++) {
+        for (int buffered = 0; ok && buffered < 2; buffered++) {
+            ok = remove_tree(dst);
+            sync();
+            double start = now_ms();
+            bytes = 0;
+            ok = ok && (buffered ? copy_tree_buffered(src, dst, &bytes) : copy_directory_recursively(src, dst));
+            double elapsed = now_ms() - start;
+            if (round == 0 || elapsed < best[buffered]) best[buffered] = elapsed;
+        }
+    }
+    minimal_log_level = level;
+    if (!ok) return false;
+
+    const char *names[2] = {"nob.h", "buffered"};
+    for (int buffered = 0; buffered < 2; buffered++) {
+        nob_log(INFO, "bench-copy: %-8s %7.2f MB in %8.2f ms, %7.1f MB/s", names[buffered], bytes/1e6, best[buffered], bytes/1e3/best[buffered]);
+    }
+    return true;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr, "Usage: %s [command]\n", program);
+    fprintf(stderr, "Commands:\n");
+    fprintf(stderr, "    build         build ./main (default)\n");
+    fprintf(stderr, "    release       build ./main with -O3 and LTO; --native adds -march=native\n");
+    fprintf(stderr, "    pgo           build ./main with LTO and a profile of replayed scripts, report before and after\n");
+    fprintf(stderr, "    dist          stage a release build of ./main with raylib in "DIST_DIR"; --native adds -march=native\n");
+    fprintf(stderr, "    test-cook     check cook.hpp against the C containers of cook.h, under sanitizers\n");
+    fprintf(stderr, "    bench-cook    run the cook.h container benchmarks\n");
+    fprintf(stderr, "    bench-lex     run the lexer throughput benchmark for every variant and corpus\n");
+    fprintf(stderr, "                  [-r rounds] [-p cpu], results in "BUILD_DIR"bench-lex.jsonl\n");
+    fprintf(stderr, "    bench-spawn   time many short compiler jobs against the old sleep-polling wait\n");
+    fprintf(stderr, "                  [-n jobs] [-j slots] [-m MB]\n");
+    fprintf(stderr, "    bench-copy    time copying a staging tree against the old buffered, serial copy\n");
+}
+
 int main(int argc, char **argv)
 {
     NOB_GO_REBUILD_URSELF(argc, argv);
 
-    cmd_append(&cmd, "cc");
-    cmd_append(&cmd, "-Wall", "-Wextra", "-Wno-unused-function");
-    cmd_append(&cmd, "-ggdb");
-    cmd_append(&cmd, "-o", "main", "main.c");
-    cmd_append(&cmd, "-lffi");
+    const char *program = shift(argv, argc);
+    const char *command = argc > 0 ? shift(argv, argc) : "build";
 
-    if (!cmd_run(&cmd)) return 1;
+    bool native = argc > 0 && strcmp(argv[0], "--native") == 0;
 
-    return 0;
-}
+    if (strcmp(command, "test-cook") == 0) return test_cook() ? 0 : 1;
+    if (strcmp(command, "bench-cook") == 0) return bench_cook() ? 0 : 1;
+    if (strcmp(command, "bench-lex") == 0) return bench_lex(argc, argv) ? 0 : 1;
+    if (strcmp(command, "bench-spawn") == 0) return bench_spawn(argc, argv) ? 0 : 1;
+    if (strcmp(command, "bench-copy") == 0) return bench_copy() ? 0 : 1;
+    if (strcmp(command, "build") != 0 && strcmp(command, "release") != 0
+        && strcmp(command, "pgo") != 0 && strcmp(command, "dist") != 0) {
+        nob_log(ERROR, "unknown command `%s`", command);
+        usage(program);
+        return 1;
+    }
 
+    /* The builds leave the timeline of their commands in TRACE_FILE; the
+     * benchmarks above time their launches themselves and stay out of it.
+     * They also share nob_nprocs() job slots with whatever they run, or the
+     * slots of the make or nob that runs them. */
+    bool ok;
+    if (!jobserver_serve(0)) return 1;
+    trace_begin(TRACE_FILE);
+    if (strcmp(command, "build") == 0) ok = build_main(PROFILE_DEBUG, false);
+    else if (strcmp(command, "release") == 0) ok = build_main(PROFILE_RELEASE, native);
+    else if (strcmp(command, "pgo") == 0) ok = pgo(native);
+    else ok = dist(native);
+    return trace_end() && ok ? 0 : 1;
+}
@@ -80,6 +80,11 @@
       - NOB_EXPERIMENTAL_DELETE_OLD - Experimental feature that automatically removes `nob.old` files. It's unclear how well
         it works on Windows, so it's experimental for now.
       - NOB_STRIP_PREFIX - string the `nob_` prefixes from non-redefinable names.
+      - NOB_TEMP_SINGLE_THREADED - Keep a single process-wide temporary storage instead of one per thread.
+      - NOB_USE_FORK - Start commands with fork() and exec on Linux too, instead of posix_spawn().
+      - NOB_NO_JOBSERVER - Don't take part in the GNU make jobserver named in MAKEFLAGS.
+      - NOB_IMPLEMENTATION_LINKED - Leave the definitions out even with NOB_IMPLEMENTATION, because they are linked
+        in from an object. See NOB_REBUILD_URSELF_OBJECT.
 
    ## Redefinable Macros
 
@@ -92,8 +97,13 @@
       - NOB_DEPRECATED(message) - Redefine how nob.h shall mark functions as deprecated.
       - NOB_DA_INIT_CAP - Redefine initial capacity of Dynamic Arrays.
       - NOB_TEMP_CAPACITY - Redefine the capacity of the temporary storate.
+      - NOB_THREAD_LOCAL - Redefine the storage class used for the per-thread temporary storage.
       - NOB_REBUILD_URSELF(binary_path, source_path) - redefine how nob.h shall rebuild itself.
+      - NOB_REBUILD_URSELF_OBJECT - Path of an object to compile the definitions of nob.h into once, instead of with
+        every rebuild. See Go Rebuild Urself™ Technology below.
+      - NOB_REBUILD_URSELF_IMPLEMENTATION(object_path, header_path) - redefine how nob.h shall compile that object.
       - NOB_WIN32_ERR_MSG_SIZE - Redefine the capacity of the buffer for error message on Windows.
+      - NOB_COPY_MAX_WORKERS - Redefine how many threads nob_copy_directory_recursively() copies files on at most.
 */
 
 #ifndef NOB_H_
@@ -165,6 +175,21 @@
 #    include <sys/stat.h>
 #    include <unistd.h>
 #    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <pthread.h>
+#    include <poll.h>
+#    ifdef __linux__
+#        include <sys/ioctl.h>
+#        include <sys/sendfile.h>
+#        include <sys/syscall.h>
+#        ifndef FICLONE
+#            define FICLONE _IOW(0x94, 9, int)
+#        endif
+#    endif
+#    if defined(__linux__) && !defined(NOB_USE_FORK)
+#        define NOB__POSIX_SPAWN
+#        include <spawn.h>
+#    endif
 #endif
 
 #ifdef _WIN32
@@ -228,7 +253,12 @@ typedef enum {
 } Nob_File_Type;
 
 NOBDEF bool nob_mkdir_if_not_exists(const char *path);
+// Copy a file, keeping its mode if dst_path doesn't exist yet. On Linux it first tries a reflink (FICLONE),
+// which shares the data on btrfs and xfs, then copy_file_range() and sendfile(), which keep the data in the
+// kernel, and only then reads and writes through a buffer.
 NOBDEF bool nob_copy_file(const char *src_path, const char *dst_path);
+// Copy a directory tree. The directories are made first, then the files are copied by up to
+// NOB_COPY_MAX_WORKERS threads, one per core.
 NOBDEF bool nob_copy_directory_recursively(const char *src_path, const char *dst_path);
 NOBDEF bool nob_read_entire_dir(const char *parent, Nob_File_Paths *children);
 NOBDEF bool nob_write_entire_file(const char *path, const void *data, size_t size);
@@ -323,6 +353,24 @@ typedef struct {
 } Nob_String_Builder;
 
 NOBDEF bool nob_read_entire_file(const char *path, Nob_String_Builder *sb);
+
+// A read-only view of a whole file. A regular file is mapped with mmap(), so nothing is copied and
+// pages come in as they are touched. What can't be mapped, like a pipe, is read into memory instead.
+typedef struct {
+    const char *data; // "" for an empty file, never NULL
+    size_t count;
+    bool mapped;      // false if it was read
+} Nob_File_Map;
+
+// Hints for nob_file_map(). They only advise the kernel about a mapping.
+#define NOB_FILE_MAP_SEQUENTIAL 0x1 // read ahead aggressively and drop the pages behind
+#define NOB_FILE_MAP_WILLNEED   0x2 // start reading the whole file in now
+#define NOB_FILE_MAP_HUGE_PAGES 0x4 // MADV_HUGEPAGE, if the filesystem can back it
+
+// The same shape as cook_file_map() of cook.h: the map first, then the path.
+NOBDEF bool nob_file_map(Nob_File_Map *map, const char *path, unsigned hints);
+NOBDEF void nob_file_unmap(Nob_File_Map *map);
+
 NOBDEF int nob_sb_appendf(Nob_String_Builder *sb, const char *fmt, ...) NOB_PRINTF_FORMAT(2, 3);
 
 // Append a sized buffer to a string builder
@@ -372,6 +420,10 @@ NOBDEF bool nob_proc_wait(Nob_Proc proc);
 // Wait until all the processes have finished
 NOBDEF bool nob_procs_wait(Nob_Procs procs);
 
+// Wait until any of the processes has finished, remove it from the procs array and return whether it succeeded.
+// On Linux it sleeps in poll() on pidfds of the processes, so it wakes up the moment one of them exits.
+NOBDEF bool nob_procs_wait_any(Nob_Procs *procs);
+
 // Wait until all the processes have finished and empty the procs array.
 NOBDEF bool nob_procs_flush(Nob_Procs *procs);
 
@@ -415,6 +467,25 @@ NOBDEF int nob_nprocs(void);
 // The maximum time span representable is 584 years.
 NOBDEF uint64_t nob_nanos_since_unspecified_epoch(void);
 
+// Between nob_trace_begin() and nob_trace_end() every command nob starts is recorded: when it started and
+// when it was reaped, the job slot it took and its exit status (128 + the signal if it was killed).
+// nob_trace_end() writes them to path as a Chrome trace, to open in https://ui.perfetto.dev or
+// chrome://tracing, and logs how busy the slots were and the critical path. Not thread safe.
+NOBDEF void nob_trace_begin(const char *path);
+NOBDEF bool nob_trace_end(void);
+
+// GNU make jobserver. When MAKEFLAGS carries --jobserver-auth=fifo:PATH or --jobserver-auth=R,W, as it does
+// in a recipe of make -jN marked with + or under a nob that called nob_jobserver_serve(), nob_cmd_run_opt()
+// takes a token from the jobserver for every process it runs next to one already running, and each token
+// goes back when a process is reaped. Nested builds then share the -j of the outermost one. A synchronous
+// command started while asynchronous ones run takes a token only if one is free right away. Define
+// NOB_NO_JOBSERVER to opt out. POSIX only.
+//
+// nob_jobserver_serve() makes this process the jobserver of its children, with jobs slots (nob_nprocs()
+// if 0): a pipe holding jobs - 1 tokens, exported in MAKEFLAGS. It does nothing when there is a jobserver
+// already.
+NOBDEF bool nob_jobserver_serve(size_t jobs);
+
 // Same as nob_cmd_run_opt but using cool variadic macro to set the default options.
 // See https://x.com/vkrajacic/status/1749816169736073295 for more info on how to use such macros.
 #define nob_cmd_run(cmd, ...) nob_cmd_run_opt((cmd), (Nob_Cmd_Opt){__VA_ARGS__})
@@ -520,6 +591,60 @@ NOBDEF bool nob_cmd_run_sync_redirect_and_reset(Nob_Cmd *cmd, Nob_Cmd_Redirect r
 #ifndef NOB_TEMP_CAPACITY
 #define NOB_TEMP_CAPACITY (8*1024*1024)
 #endif // NOB_TEMP_CAPACITY
+
+#ifndef NOB_COPY_MAX_WORKERS
+#define NOB_COPY_MAX_WORKERS 16
+#endif // NOB_COPY_MAX_WORKERS
+
+#ifndef NOB_THREAD_LOCAL
+#  if defined(NOB_TEMP_SINGLE_THREADED)
+#    define NOB_THREAD_LOCAL
+#  elif defined(__cplusplus)
+#    define NOB_THREAD_LOCAL thread_local
+#  elif defined(_MSC_VER)
+#    define NOB_THREAD_LOCAL __declspec(thread)
+#  elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#    define NOB_THREAD_LOCAL _Thread_local
+#  else
+#    define NOB_THREAD_LOCAL __thread
+#  endif
+#endif // NOB_THREAD_LOCAL
+
+// An arena is a bump allocator over a caller-provided buffer. It is what the temporary storage is
+// built on, and you can use one directly when you want to hand a specific allocation context to
+// some code (for example to a worker thread) instead of relying on the implicit temporary storage.
+//
+// ```c
+// static char buffer[64*1024];
+// Nob_Arena arena = nob_arena_from_buffer(buffer, sizeof(buffer));
+// char *path = nob_arena_sprintf(&arena, "%s/%s", dir, name);
+// ```
+typedef struct {
+    char *data;
+    size_t capacity;
+    size_t size;
+} Nob_Arena;
+
+NOBDEF Nob_Arena nob_arena_from_buffer(void *buffer, size_t capacity);
+NOBDEF void *nob_arena_alloc(Nob_Arena *arena, size_t size);
+NOBDEF char *nob_arena_strdup(Nob_Arena *arena, const char *cstr);
+NOBDEF char *nob_arena_sprintf(Nob_Arena *arena, const char *format, ...) NOB_PRINTF_FORMAT(2, 3);
+NOBDEF char *nob_arena_vsprintf(Nob_Arena *arena, const char *format, va_list args);
+NOBDEF void nob_arena_reset(Nob_Arena *arena);
+NOBDEF size_t nob_arena_save(Nob_Arena *arena);
+NOBDEF void nob_arena_rewind(Nob_Arena *arena, size_t checkpoint);
+
+// The temporary storage is an arena that is current for the calling thread. Each thread gets its own
+// NOB_TEMP_CAPACITY buffer on the first temporary allocation (unless NOB_TEMP_SINGLE_THREADED is defined),
+// so nob_temp_*() functions are safe to call from several threads at once. nob_temp_set_arena() replaces
+// the current arena of the calling thread and returns the previous one, NULL standing for the default.
+// Passing NULL restores the default.
+NOBDEF Nob_Arena *nob_temp_arena(void);
+NOBDEF Nob_Arena *nob_temp_set_arena(Nob_Arena *arena);
+// Free the default temporary buffer of the calling thread. Call it before a worker thread exits if it
+// used the temporary storage. It is allocated again if the thread keeps using the temporary storage.
+NOBDEF void nob_temp_release_thread_buffer(void);
+
 NOBDEF char *nob_temp_strdup(const char *cstr);
 NOBDEF void *nob_temp_alloc(size_t size);
 NOBDEF char *nob_temp_sprintf(const char *format, ...) NOB_PRINTF_FORMAT(1, 2);
@@ -618,6 +743,14 @@ NOBDEF bool nob_set_current_dir(const char *path);
 #  endif
 #endif
 
+#if defined(NOB_REBUILD_URSELF_OBJECT) && !defined(NOB_REBUILD_URSELF_IMPLEMENTATION)
+#  if defined(_MSC_VER)
+#    error "Define NOB_REBUILD_URSELF_IMPLEMENTATION(object_path, header_path) to compile nob.h with cl.exe"
+#  else
+#    define NOB_REBUILD_URSELF_IMPLEMENTATION(object_path, header_path) "cc", "-x", "c", "-c", "-o", object_path, header_path
+#  endif
+#endif
+
 // Go Rebuild Urself™ Technology
 //
 //   How to use it:
@@ -640,6 +773,14 @@ NOBDEF bool nob_set_current_dir(const char *path);
 //   do not recommend since the whole idea of NoBuild is to keep the process of bootstrapping
 //   as simple as possible and doing all of the actual work inside of ./nob)
 //
+//   Most of what a rebuild compiles is the implementation of nob.h. With
+//   #define NOB_REBUILD_URSELF_OBJECT "build/nob.o" it compiles that once into the object, with
+//   NOB_REBUILD_URSELF_IMPLEMENTATION and the configuration macros of the source (NOB_USE_FORK and
+//   the like), and links it in, leaving the implementation out of the source with
+//   NOB_IMPLEMENTATION_LINKED. A change to nob.h then rebuilds the executable too, and the object is
+//   compiled again when nob.h is newer than it or the configuration changed. Redefining NOB_REALLOC,
+//   NOB_FREE, NOB_ASSERT or the NOB_REBUILD_URSELF* commands doesn't carry over to the object.
+//
 NOBDEF void nob__go_rebuild_urself(int argc, char **argv, const char *source_path, ...);
 #define NOB_GO_REBUILD_URSELF(argc, argv) nob__go_rebuild_urself(argc, argv, __FILE__, NULL)
 // Sometimes your nob.c includes additional files, so you want the Go Rebuild Urself™ Technology to check
@@ -760,7 +901,7 @@ NOBDEF char *nob_win32_error_message(DWORD err);
 
 #endif // NOB_H_
 
-#ifdef NOB_IMPLEMENTATION
+#if defined(NOB_IMPLEMENTATION) && !defined(NOB_IMPLEMENTATION_LINKED)
 
 // This is like nob_proc_wait() but waits asynchronously. Depending on the platform ms means different thing.
 // On Windows it means timeout. On POSIX it means for how long to sleep after checking if the process exited,
@@ -769,6 +910,15 @@ static int nob__proc_wait_async(Nob_Proc proc, int ms);
 
 // Starts the process for the command. Its main purpose is to be the base for nob_cmd_run() and nob_cmd_run_opt().
 static Nob_Proc nob__cmd_start_process(Nob_Cmd cmd, Nob_Fd *fdin, Nob_Fd *fdout, Nob_Fd *fderr);
+static void nob__proc_exited(Nob_Proc proc, int exit_status);
+static bool nob__jobserver_acquire(Nob_Procs *procs);
+#if defined(__linux__) && defined(SYS_pidfd_open)
+static size_t nob__procs_poll(Nob_Procs procs, int fd);
+#endif
+
+#ifdef NOB__POSIX_SPAWN
+extern char **environ;
+#endif
 
 // Any messages with the level below nob_minimal_log_level are going to be suppressed.
 Nob_Log_Level nob_minimal_log_level = NOB_INFO;
@@ -814,6 +964,63 @@ NOBDEF char *nob_win32_error_message(DWORD err) {
 #endif // _WIN32
 
 // The implementation idea is stolen from https://github.com/zhiayang/nabs
+#ifdef NOB_REBUILD_URSELF_OBJECT
+#define NOB__STRINGIFY(x) NOB__STRINGIFY2(x)
+#define NOB__STRINGIFY2(x) #x
+
+// Compiles the implementation with the configuration of the source including it, so they agree
+static void nob__rebuild_urself_implementation_cmd(Nob_Cmd *cmd)
+{
+    nob_cmd_append(cmd, NOB_REBUILD_URSELF_IMPLEMENTATION(NOB_REBUILD_URSELF_OBJECT, __FILE__));
+    // The rebuild itself is in the object
+    nob_cmd_append(cmd, "-DNOB_IMPLEMENTATION", "-DNOB_REBUILD_URSELF_OBJECT=" NOB__STRINGIFY(NOB_REBUILD_URSELF_OBJECT));
+#ifdef NOB_EXPERIMENTAL_DELETE_OLD
+    nob_cmd_append(cmd, "-DNOB_EXPERIMENTAL_DELETE_OLD");
+#endif
+#ifdef NOB_TEMP_SINGLE_THREADED
+    nob_cmd_append(cmd, "-DNOB_TEMP_SINGLE_THREADED");
+#endif
+#ifdef NOB_USE_FORK
+    nob_cmd_append(cmd, "-DNOB_USE_FORK");
+#endif
+#ifdef NOB_NO_JOBSERVER
+    nob_cmd_append(cmd, "-DNOB_NO_JOBSERVER");
+#endif
+#ifdef NOB_NO_MINIRENT
+    nob_cmd_append(cmd, "-DNOB_NO_MINIRENT");
+#endif
+    nob_cmd_append(cmd, "-DNOB_DA_INIT_CAP=" NOB__STRINGIFY(NOB_DA_INIT_CAP));
+    nob_cmd_append(cmd, "-DNOB_TEMP_CAPACITY=" NOB__STRINGIFY(NOB_TEMP_CAPACITY));
+    nob_cmd_append(cmd, "-DNOB_COPY_MAX_WORKERS=" NOB__STRINGIFY(NOB_COPY_MAX_WORKERS));
+}
+
+// Whether the object must be compiled again: 1 if it is missing, nob.h is newer or the command to compile it
+// changed, which NOB_REBUILD_URSELF_OBJECT.cmd keeps. 0 if not, -1 on error.
+static int nob__rebuild_urself_implementation_is_stale(const Nob_Cmd *cmd, Nob_String_Builder *rendered)
+{
+    nob_cmd_render(*cmd, rendered);
+    int stale = nob_needs_rebuild1(NOB_REBUILD_URSELF_OBJECT, __FILE__);
+    if (stale != 0) return stale;
+
+    Nob_String_Builder saved = {0};
+    const char *cmd_path = NOB_REBUILD_URSELF_OBJECT".cmd";
+    stale = nob_file_exists(cmd_path) != 1 || !nob_read_entire_file(cmd_path, &saved)
+        || saved.count != rendered->count || memcmp(saved.items, rendered->items, saved.count) != 0;
+    nob_sb_free(saved);
+    return stale;
+}
+
+static bool nob__rebuild_urself_implementation(Nob_Cmd *cmd, const Nob_String_Builder *rendered)
+{
+    const char *object_path = NOB_REBUILD_URSELF_OBJECT;
+    const char *slash = strrchr(object_path, '/');
+    if (slash && !nob_mkdir_if_not_exists(nob_temp_sprintf("%.*s", (int) (slash - object_path), object_path))) return false;
+    Nob_Cmd_Opt opt = {0};
+    return nob_cmd_run_opt(cmd, opt)
+        && nob_write_entire_file(NOB_REBUILD_URSELF_OBJECT".cmd", rendered->items, rendered->count);
+}
+#endif // NOB_REBUILD_URSELF_OBJECT
+
 NOBDEF void nob__go_rebuild_urself(int argc, char **argv, const char *source_path, ...)
 {
     const char *binary_path = nob_shift(argv, argc);
@@ -836,6 +1043,11 @@ NOBDEF void nob__go_rebuild_urself(int argc, char **argv, const char *source_pat
     }
     va_end(args);
 
+#ifdef NOB_REBUILD_URSELF_OBJECT
+    // nob.h is compiled on its own then, so it is a source like the others
+    nob_da_append(&source_paths, __FILE__);
+#endif
+
     int rebuild_is_needed = nob_needs_rebuild(binary_path, source_paths.items, source_paths.count);
     if (rebuild_is_needed < 0) exit(1); // error
     if (!rebuild_is_needed) {           // no rebuild is needed
@@ -848,8 +1060,23 @@ NOBDEF void nob__go_rebuild_urself(int argc, char **argv, const char *source_pat
     const char *old_binary_path = nob_temp_sprintf("%s.old", binary_path);
 
     if (!nob_rename(binary_path, old_binary_path)) exit(1);
-    nob_cmd_append(&cmd, NOB_REBUILD_URSELF(binary_path, source_path));
     Nob_Cmd_Opt opt = {0};
+#ifdef NOB_REBUILD_URSELF_OBJECT
+    Nob_Cmd implementation = {0};
+    Nob_String_Builder implementation_rendered = {0};
+    nob__rebuild_urself_implementation_cmd(&implementation);
+    int implementation_is_stale = nob__rebuild_urself_implementation_is_stale(&implementation, &implementation_rendered);
+    if (implementation_is_stale < 0
+        || (implementation_is_stale && !nob__rebuild_urself_implementation(&implementation, &implementation_rendered))) {
+        nob_rename(old_binary_path, binary_path);
+        exit(1);
+    }
+    nob_cmd_free(implementation);
+    nob_sb_free(implementation_rendered);
+    nob_cmd_append(&cmd, NOB_REBUILD_URSELF(binary_path, source_path), "-DNOB_IMPLEMENTATION_LINKED", NOB_REBUILD_URSELF_OBJECT);
+#else
+    nob_cmd_append(&cmd, NOB_REBUILD_URSELF(binary_path, source_path));
+#endif
     if (!nob_cmd_run_opt(&cmd, opt)) {
         nob_rename(old_binary_path, binary_path);
         exit(1);
@@ -867,9 +1094,6 @@ NOBDEF void nob__go_rebuild_urself(int argc, char **argv, const char *source_pat
     exit(0);
 }
 
-static size_t nob_temp_size = 0;
-static char nob_temp[NOB_TEMP_CAPACITY] = {0};
-
 NOBDEF bool nob_mkdir_if_not_exists(const char *path)
 {
 #ifdef _WIN32
@@ -890,6 +1114,48 @@ NOBDEF bool nob_mkdir_if_not_exists(const char *path)
     return true;
 }
 
+#ifdef __linux__
+// Whether an in-kernel copy failed only because the files don't support it
+static bool nob__copy_unsupported(int err)
+{
+    return err == ENOSYS || err == EXDEV || err == EINVAL || err == EOPNOTSUPP || err == ENOTTY || err == EBADF;
+}
+
+// Copies src_fd to dst_fd, both at offset 0, without the data passing through nob. Returns 1 if it's
+// done, 0 if none of the ways are supported for these files and nothing was written, -1 on an error.
+static int nob__copy_fd_in_kernel(int src_fd, int dst_fd)
+{
+    if (ioctl(dst_fd, FICLONE, src_fd) == 0) return 1;
+
+    bool copied = false;
+#ifdef SYS_copy_file_range
+    for (;;) {
+        ssize_t n = (ssize_t) syscall(SYS_copy_file_range, src_fd, NULL, dst_fd, NULL, (size_t) 1 << 30, 0);
+        if (n == 0) return 1;
+        if (n > 0) {
+            copied = true;
+            continue;
+        }
+        if (errno == EINTR) continue;
+        if (copied || !nob__copy_unsupported(errno)) return -1;
+        break;
+    }
+#endif // SYS_copy_file_range
+
+    for (;;) {
+        ssize_t n = sendfile(dst_fd, src_fd, NULL, (size_t) 1 << 30);
+        if (n == 0) return 1;
+        if (n > 0) {
+            copied = true;
+            continue;
+        }
+        if (errno == EINTR) continue;
+        if (copied || !nob__copy_unsupported(errno)) return -1;
+        return 0;
+    }
+}
+#endif // __linux__
+
 NOBDEF bool nob_copy_file(const char *src_path, const char *dst_path)
 {
     nob_log(NOB_INFO, "copying %s -> %s", src_path, dst_path);
@@ -903,8 +1169,7 @@ NOBDEF bool nob_copy_file(const char *src_path, const char *dst_path)
     int src_fd = -1;
     int dst_fd = -1;
     size_t buf_size = 32*1024;
-    char *buf = (char*)NOB_REALLOC(NULL, buf_size);
-    NOB_ASSERT(buf != NULL && "Buy more RAM lol!!");
+    char *buf = NULL;
     bool result = true;
 
     src_fd = open(src_path, O_RDONLY);
@@ -925,6 +1190,20 @@ NOBDEF bool nob_copy_file(const char *src_path, const char *dst_path)
         nob_return_defer(false);
     }
 
+#ifdef __linux__
+    // Files in /proc and the like claim to be empty, so only a read sees what they hold
+    if (src_stat.st_size > 0) {
+        int ret = nob__copy_fd_in_kernel(src_fd, dst_fd);
+        if (ret < 0) {
+            nob_log(NOB_ERROR, "Could not copy %s to %s: %s", src_path, dst_path, strerror(errno));
+            nob_return_defer(false);
+        }
+        if (ret > 0) nob_return_defer(true);
+    }
+#endif // __linux__
+
+    buf = (char*)NOB_REALLOC(NULL, buf_size);
+    NOB_ASSERT(buf != NULL && "Buy more RAM lol!!");
     for (;;) {
         ssize_t n = read(src_fd, buf, buf_size);
         if (n == 0) break;
@@ -1036,16 +1315,10 @@ NOBDEF bool nob_cmd_run_opt(Nob_Cmd *cmd, Nob_Cmd_Opt opt)
 
     if (opt.async && max_procs > 0) {
         while (opt.async->count >= max_procs) {
-            for (size_t i = 0; i < opt.async->count; ++i) {
-                int ret = nob__proc_wait_async(opt.async->items[i], 1);
-                if (ret < 0) nob_return_defer(false);
-                if (ret) {
-                    nob_da_remove_unordered(opt.async, i);
-                    break;
-                }
-            }
+            if (!nob_procs_wait_any(opt.async)) nob_return_defer(false);
         }
     }
+    if (!nob__jobserver_acquire(opt.async)) nob_return_defer(false);
 
     if (opt.stdin_path) {
         fdin = nob_fd_open_for_read(opt.stdin_path);
@@ -1107,7 +1380,7 @@ NOBDEF Nob_Proc nob_cmd_run_async_redirect(Nob_Cmd cmd, Nob_Cmd_Redirect redirec
     return nob__cmd_start_process(cmd, redirect.fdin, redirect.fdout, redirect.fderr);
 }
 
-static Nob_Proc nob__cmd_start_process(Nob_Cmd cmd, Nob_Fd *fdin, Nob_Fd *fdout, Nob_Fd *fderr)
+static Nob_Proc nob__cmd_spawn(Nob_Cmd cmd, Nob_Fd *fdin, Nob_Fd *fdout, Nob_Fd *fderr)
 {
     if (cmd.count < 1) {
         nob_log(NOB_ERROR, "Could not run empty command");
@@ -1151,6 +1424,34 @@ static Nob_Proc nob__cmd_start_process(Nob_Cmd cmd, Nob_Fd *fdin, Nob_Fd *fdout,
     CloseHandle(piProcInfo.hThread);
 
     return piProcInfo.hProcess;
+#elif defined(NOB__POSIX_SPAWN)
+    // Unlike fork(), posix_spawn() doesn't copy the page tables of nob, so starting a command costs the same
+    // however much memory nob holds. glibc does it with clone(CLONE_VM | CLONE_VFORK) and reports a failed exec.
+    posix_spawn_file_actions_t actions;
+    Nob_Cmd cmd_null = {0};
+    pid_t cpid = 0;
+
+    int err = posix_spawn_file_actions_init(&actions);
+    if (err != 0) {
+        nob_log(NOB_ERROR, "Could not spawn child process for %s: %s", cmd.items[0], strerror(err));
+        return NOB_INVALID_PROC;
+    }
+    if (fdin)              err = posix_spawn_file_actions_adddup2(&actions, *fdin, STDIN_FILENO);
+    if (err == 0 && fdout) err = posix_spawn_file_actions_adddup2(&actions, *fdout, STDOUT_FILENO);
+    if (err == 0 && fderr) err = posix_spawn_file_actions_adddup2(&actions, *fderr, STDERR_FILENO);
+
+    nob_da_append_many(&cmd_null, cmd.items, cmd.count);
+    nob_cmd_append(&cmd_null, NULL);
+    if (err == 0) err = posix_spawnp(&cpid, cmd.items[0], &actions, NULL, (char * const*) cmd_null.items, environ);
+    posix_spawn_file_actions_destroy(&actions);
+    nob_cmd_free(cmd_null);
+
+    if (err != 0) {
+        nob_log(NOB_ERROR, "Could not spawn child process for %s: %s", cmd.items[0], strerror(err));
+        return NOB_INVALID_PROC;
+    }
+
+    return cpid;
 #else
     pid_t cpid = fork();
     if (cpid < 0) {
@@ -1197,6 +1498,325 @@ static Nob_Proc nob__cmd_start_process(Nob_Cmd cmd, Nob_Fd *fdin, Nob_Fd *fdout,
 #endif
 }
 
+typedef struct {
+    char *command;      // rendered
+    Nob_Proc proc;
+    uint64_t start_ns;
+    uint64_t end_ns;    // 0 while it runs
+    size_t slot;
+    int exit_status;    // -1 if it was never reaped
+} Nob__Trace_Event;
+
+typedef struct {
+    Nob__Trace_Event *items;
+    size_t count;
+    size_t capacity;
+} Nob__Trace_Events;
+
+typedef struct {
+    bool initialized;
+    int read_fd;                // -1 without a jobserver
+    int write_fd;
+    bool blocking;              // read_fd is make's own end of the pipe
+    size_t running;             // processes started and not reaped yet
+    Nob_String_Builder held;    // the tokens taken, to give back byte for byte
+} Nob__Jobserver;
+
+static Nob__Jobserver nob__jobserver = {false, -1, -1, false, 0, {0}};
+
+static const char *nob__trace_path = NULL;
+static uint64_t nob__trace_begin_ns = 0;
+static Nob__Trace_Events nob__trace_events = {0};
+
+// The lowest slot none of the running commands holds
+static size_t nob__trace_free_slot(void)
+{
+    for (size_t slot = 0;; ++slot) {
+        bool taken = false;
+        for (size_t i = 0; i < nob__trace_events.count && !taken; ++i) {
+            Nob__Trace_Event *event = &nob__trace_events.items[i];
+            taken = event->end_ns == 0 && event->slot == slot;
+        }
+        if (!taken) return slot;
+    }
+}
+
+static Nob_Proc nob__cmd_start_process(Nob_Cmd cmd, Nob_Fd *fdin, Nob_Fd *fdout, Nob_Fd *fderr)
+{
+    uint64_t start_ns = nob_nanos_since_unspecified_epoch();
+    Nob_Proc proc = nob__cmd_spawn(cmd, fdin, fdout, fderr);
+    if (proc != NOB_INVALID_PROC) nob__jobserver.running += 1;
+    if (nob__trace_path == NULL || proc == NOB_INVALID_PROC) return proc;
+
+    Nob_String_Builder sb = {0};
+    nob_cmd_render(cmd, &sb);
+    nob_sb_append_null(&sb);
+    Nob__Trace_Event event = {sb.items, proc, start_ns, 0, nob__trace_free_slot(), -1};
+    nob_da_append(&nob__trace_events, event);
+    return proc;
+}
+
+static void nob__jobserver_release(void);
+
+// Called wherever a process is reaped
+static void nob__proc_exited(Nob_Proc proc, int exit_status)
+{
+    if (nob__jobserver.running > 0) nob__jobserver.running -= 1;
+    nob__jobserver_release();
+
+    if (nob__trace_path == NULL) return;
+    for (size_t i = nob__trace_events.count; i > 0; --i) {
+        Nob__Trace_Event *event = &nob__trace_events.items[i - 1];
+        if (event->end_ns == 0 && event->proc == proc) {
+            event->end_ns = nob_nanos_since_unspecified_epoch();
+            event->exit_status = exit_status;
+            return;
+        }
+    }
+}
+
+static void nob__jobserver_init(void)
+{
+    if (nob__jobserver.initialized) return;
+    nob__jobserver.initialized = true;
+#if !defined(_WIN32) && !defined(NOB_NO_JOBSERVER)
+    const char *flags = getenv("MAKEFLAGS");
+    if (flags == NULL) return;
+
+    // The last one counts, --jobserver-fds is what make before 4.2 called it
+    const char *auth = NULL;
+    for (const char *p = flags; (p = strstr(p, "--jobserver-")) != NULL; ++p) {
+        if (strncmp(p, "--jobserver-auth=", 17) == 0) auth = p + 17;
+        if (strncmp(p, "--jobserver-fds=", 16) == 0) auth = p + 16;
+    }
+    if (auth == NULL) return;
+
+    if (strncmp(auth, "fifo:", 5) == 0) {
+        const char *path = nob_temp_sprintf("%.*s", (int) strcspn(auth + 5, " "), auth + 5);
+        int fd = open(path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) {
+            nob_log(NOB_WARNING, "jobserver: could not open %s: %s", path, strerror(errno));
+            return;
+        }
+        nob__jobserver.read_fd = fd;
+        nob__jobserver.write_fd = fd;
+        return;
+    }
+
+    int read_fd, write_fd;
+    if (sscanf(auth, "%d,%d", &read_fd, &write_fd) != 2 || read_fd < 0 || write_fd < 0) return;
+    if (fcntl(read_fd, F_GETFD) < 0 || fcntl(write_fd, F_GETFD) < 0) {
+        nob_log(NOB_WARNING, "jobserver: the pipe in MAKEFLAGS is closed, mark the recipe with + to share it");
+        return;
+    }
+    // A description of its own, so that being non-blocking doesn't change the pipe under make. Where
+    // /proc doesn't exist it is the pipe itself, and a token can still go between poll() and read().
+    int fd = open(nob_temp_sprintf("/proc/self/fd/%d", read_fd), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    nob__jobserver.read_fd = fd >= 0 ? fd : read_fd;
+    nob__jobserver.write_fd = write_fd;
+    nob__jobserver.blocking = fd < 0;
+#endif
+}
+
+// Until it holds a token for every process running but one, which runs on the token nob itself was started
+// with. It reaps from procs while it waits, since their tokens come back only then.
+static bool nob__jobserver_acquire(Nob_Procs *procs)
+{
+    nob__jobserver_init();
+    bool result = true;
+#ifndef _WIN32
+    Nob__Jobserver *js = &nob__jobserver;
+    while (js->read_fd >= 0 && js->held.count < js->running) {
+        char token;
+        struct pollfd pfd = {js->read_fd, POLLIN, 0};
+        ssize_t n = -1;
+        errno = EAGAIN;
+        if (!js->blocking || poll(&pfd, 1, 0) > 0) n = read(js->read_fd, &token, 1);
+        if (n == 1) {
+            nob_da_append(&js->held, token);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+            nob_log(NOB_WARNING, "jobserver: could not take a token, running without the jobserver");
+            js->read_fd = -1;
+            break;
+        }
+        // The tokens this process holds are tied up in processes that are not in procs
+        if (procs == NULL || procs->count == 0) break;
+
+        size_t i = procs->count + 1;
+#if defined(__linux__) && defined(SYS_pidfd_open)
+        i = nob__procs_poll(*procs, js->read_fd);
+#endif
+        if (i == procs->count) continue;
+        if (i < procs->count) {
+            Nob_Proc proc = procs->items[i];
+            nob_da_remove_unordered(procs, i);
+            result = nob_proc_wait(proc) && result;
+            continue;
+        }
+        // Without pidfds look at each process and give the jobserver a millisecond
+        for (size_t j = 0; j < procs->count; ++j) {
+            int ret = nob__proc_wait_async(procs->items[j], 0);
+            if (ret != 0) {
+                nob_da_remove_unordered(procs, j);
+                result = ret > 0 && result;
+                break;
+            }
+        }
+        poll(&pfd, 1, 1);
+    }
+#else
+    NOB_UNUSED(procs);
+#endif
+    return result;
+}
+
+// Gives back the tokens the processes still running don't need
+static void nob__jobserver_release(void)
+{
+#ifndef _WIN32
+    Nob__Jobserver *js = &nob__jobserver;
+    size_t needed = js->running > 0 ? js->running - 1 : 0;
+    while (js->held.count > needed) {
+        ssize_t n = write(js->write_fd, &js->held.items[js->held.count - 1], 1);
+        if (n < 0 && errno == EINTR) continue;
+        if (n != 1) nob_log(NOB_WARNING, "jobserver: could not give a token back: %s", strerror(errno));
+        js->held.count -= 1;
+    }
+#endif
+}
+
+NOBDEF bool nob_jobserver_serve(size_t jobs)
+{
+#if !defined(_WIN32) && !defined(NOB_NO_JOBSERVER)
+    nob__jobserver_init();
+    if (nob__jobserver.read_fd >= 0) return true;
+    if (jobs == 0) jobs = (size_t) nob_nprocs();
+
+    // A pipe the children inherit rather than a fifo, which make before 4.4 doesn't take
+    int fds[2];
+    if (pipe(fds) < 0) {
+        nob_log(NOB_ERROR, "jobserver: could not create a pipe: %s", strerror(errno));
+        return false;
+    }
+    for (size_t i = 1; i < jobs; ++i) {
+        if (write(fds[1], "+", 1) != 1) {
+            nob_log(NOB_ERROR, "jobserver: could not fill the pipe: %s", strerror(errno));
+            close(fds[0]);
+            close(fds[1]);
+            return false;
+        }
+    }
+
+    const char *flags = getenv("MAKEFLAGS");
+    const char *value = nob_temp_sprintf("%s -j%zu --jobserver-auth=%d,%d", flags ? flags : "", jobs, fds[0], fds[1]);
+    if (setenv("MAKEFLAGS", value, 1) < 0) {
+        nob_log(NOB_ERROR, "jobserver: could not set MAKEFLAGS: %s", strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    nob__jobserver.initialized = false;
+    nob__jobserver_init();
+#else
+    NOB_UNUSED(jobs);
+#endif
+    return true;
+}
+
+NOBDEF void nob_trace_begin(const char *path)
+{
+    nob__trace_path = path;
+    nob__trace_begin_ns = nob_nanos_since_unspecified_epoch();
+    nob__trace_events.count = 0;
+}
+
+static void nob__sb_append_json_string(Nob_String_Builder *sb, const char *cstr)
+{
+    nob_da_append(sb, '"');
+    for (const char *p = cstr; *p; ++p) {
+        if (*p == '"' || *p == '\\') {
+            nob_da_append(sb, '\\');
+            nob_da_append(sb, *p);
+        } else if ((unsigned char) *p < 0x20) {
+            nob_sb_appendf(sb, "\\u%04x", (unsigned char) *p);
+        } else {
+            nob_da_append(sb, *p);
+        }
+    }
+    nob_da_append(sb, '"');
+}
+
+NOBDEF bool nob_trace_end(void)
+{
+    if (nob__trace_path == NULL) return true;
+    const char *path = nob__trace_path;
+    uint64_t end_ns = nob_nanos_since_unspecified_epoch();
+    Nob__Trace_Events *events = &nob__trace_events;
+    Nob_String_Builder sb = {0};
+    nob__trace_path = NULL;
+    if (events->count == 0) return true;
+
+    size_t slots = 0;
+    uint64_t busy_ns = 0;
+    for (size_t i = 0; i < events->count; ++i) {
+        Nob__Trace_Event *event = &events->items[i];
+        if (event->end_ns == 0) event->end_ns = end_ns;
+        if (event->slot + 1 > slots) slots = event->slot + 1;
+        busy_ns += event->end_ns - event->start_ns;
+    }
+
+    nob_sb_appendf(&sb, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n");
+    for (size_t slot = 0; slot < slots; ++slot) {
+        nob_sb_appendf(&sb, "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %zu, \"args\": {\"name\": \"slot %zu\"}},\n", slot, slot);
+    }
+    for (size_t i = 0; i < events->count; ++i) {
+        Nob__Trace_Event *event = &events->items[i];
+        nob_sb_appendf(&sb, "{\"name\": ");
+        nob__sb_append_json_string(&sb, event->command);
+        nob_sb_appendf(&sb, ", \"cat\": \"command\", \"ph\": \"X\", \"pid\": 1, \"tid\": %zu, \"ts\": %.3f, \"dur\": %.3f, \"args\": {\"exit\": %d}}%s\n",
+                       event->slot, (event->start_ns - nob__trace_begin_ns)/1e3, (event->end_ns - event->start_ns)/1e3,
+                       event->exit_status, i + 1 < events->count ? "," : "");
+    }
+    nob_sb_appendf(&sb, "]}\n");
+    bool result = nob_write_entire_file(path, sb.items, sb.count);
+
+    // The critical path walks back from the command that finished last, each time to the one that finished
+    // last before it started: the chain of commands that each held up the next, as far as nob can tell.
+    size_t path_count = 0, longest = 0;
+    uint64_t path_ns = 0;
+    uint64_t before_ns = UINT64_MAX;
+    for (;;) {
+        size_t next = events->count;
+        for (size_t i = 0; i < events->count; ++i) {
+            Nob__Trace_Event *event = &events->items[i];
+            if (event->end_ns <= before_ns && (next == events->count || event->end_ns > events->items[next].end_ns)) next = i;
+        }
+        if (next == events->count) break;
+        Nob__Trace_Event *event = &events->items[next];
+        if (path_count == 0 || event->end_ns - event->start_ns > events->items[longest].end_ns - events->items[longest].start_ns) longest = next;
+        path_count += 1;
+        path_ns += event->end_ns - event->start_ns;
+        before_ns = event->start_ns;
+    }
+
+    double wall_ms = (end_ns - nob__trace_begin_ns)/1e6;
+    int cores = nob_nprocs();
+    nob_log(NOB_INFO, "trace: %zu commands in %.2f ms, %.2f ms of command time, %.2f running on average in %zu slots on %d cores (%.0f%% busy)",
+            events->count, wall_ms, busy_ns/1e6, busy_ns/1e6/wall_ms, slots, cores, 100*busy_ns/1e6/wall_ms/cores);
+    nob_log(NOB_INFO, "trace: critical path of %zu commands, %.2f ms (%.0f%% of the time), longest %.2f ms: %s",
+            path_count, path_ns/1e6, 100*path_ns/1e6/wall_ms,
+            (events->items[longest].end_ns - events->items[longest].start_ns)/1e6, events->items[longest].command);
+    if (result) nob_log(NOB_INFO, "trace: written to %s", path);
+
+    for (size_t i = 0; i < events->count; ++i) NOB_FREE(events->items[i].command);
+    events->count = 0;
+    nob_sb_free(sb);
+    return result;
+}
+
 NOBDEF Nob_Proc nob_cmd_run_async(Nob_Cmd cmd)
 {
     return nob__cmd_start_process(cmd, NULL, NULL, NULL);
@@ -1307,13 +1927,87 @@ NOBDEF void nob_fd_close(Nob_Fd fd)
 
 NOBDEF bool nob_procs_wait(Nob_Procs procs)
 {
+    // In the order they finish, so each one is reaped (and traced) the moment it exits
+    Nob_Procs left = {0};
     bool success = true;
-    for (size_t i = 0; i < procs.count; ++i) {
-        success = nob_proc_wait(procs.items[i]) && success;
+    nob_da_append_many(&left, procs.items, procs.count);
+    while (left.count > 0) {
+        success = nob_procs_wait_any(&left) && success;
     }
+    nob_da_free(left);
     return success;
 }
 
+#if defined(__linux__) && defined(SYS_pidfd_open)
+// The index of a process that has exited, procs.count if fd (when not -1) became readable first, or
+// procs.count + 1 if polling is not possible
+static size_t nob__procs_poll(Nob_Procs procs, int fd)
+{
+    size_t result = procs.count + 1;
+    size_t opened = 0;
+    size_t checkpoint = nob_temp_save();
+    struct pollfd *fds = (struct pollfd*)nob_temp_alloc((procs.count + 1)*sizeof(*fds));
+    if (fds == NULL) nob_return_defer(procs.count + 1);
+
+    for (; opened < procs.count; ++opened) {
+        int pidfd = (int) syscall(SYS_pidfd_open, procs.items[opened], 0);
+        if (pidfd < 0) nob_return_defer(procs.count + 1);
+        fds[opened].fd = pidfd;
+        fds[opened].events = POLLIN;
+        fds[opened].revents = 0;
+    }
+    fds[procs.count].fd = fd;
+    fds[procs.count].events = POLLIN;
+    fds[procs.count].revents = 0;
+    while (poll(fds, (nfds_t) procs.count + (fd >= 0), -1) < 0) {
+        if (errno != EINTR) nob_return_defer(procs.count + 1);
+    }
+    for (size_t i = 0; i <= procs.count; ++i) {
+        if (fds[i].revents) nob_return_defer(i);
+    }
+
+defer:
+    for (size_t i = 0; i < opened; ++i) close(fds[i].fd);
+    nob_temp_rewind(checkpoint);
+    return result;
+}
+#endif
+
+NOBDEF bool nob_procs_wait_any(Nob_Procs *procs)
+{
+    if (procs->count == 0) return true;
+
+#ifdef _WIN32
+    DWORD count = procs->count < MAXIMUM_WAIT_OBJECTS ? (DWORD) procs->count : MAXIMUM_WAIT_OBJECTS;
+    DWORD result = WaitForMultipleObjects(count, procs->items, FALSE, INFINITE);
+    // If that fails, wait for the first one in full
+    size_t i = result >= WAIT_OBJECT_0 && result < WAIT_OBJECT_0 + count ? result - WAIT_OBJECT_0 : 0;
+#else
+    size_t i = procs->count;
+#if defined(__linux__) && defined(SYS_pidfd_open)
+    i = nob__procs_poll(*procs, -1);
+    if (i > procs->count) i = procs->count;
+#endif
+    // Without pidfds look at each process in turn and sleep a millisecond between the rounds
+    while (i == procs->count) {
+        for (size_t j = 0; j < procs->count; ++j) {
+            int ret = nob__proc_wait_async(procs->items[j], 0);
+            if (ret != 0) {
+                nob_da_remove_unordered(procs, j);
+                return ret > 0;
+            }
+        }
+        struct timespec duration = {.tv_sec = 0, .tv_nsec = 1000*1000};
+        nanosleep(&duration, NULL);
+    }
+#endif
+
+    // It has exited, so this doesn't block
+    Nob_Proc proc = procs->items[i];
+    nob_da_remove_unordered(procs, i);
+    return nob_proc_wait(proc);
+}
+
 NOBDEF bool nob_procs_flush(Nob_Procs *procs)
 {
     bool success = nob_procs_wait(*procs);
@@ -1346,6 +2040,7 @@ NOBDEF bool nob_proc_wait(Nob_Proc proc)
         nob_log(NOB_ERROR, "could not get process exit code: %s", nob_win32_error_message(GetLastError()));
         return false;
     }
+    nob__proc_exited(proc, (int) exit_status);
 
     if (exit_status != 0) {
         nob_log(NOB_ERROR, "command exited with exit code %lu", exit_status);
@@ -1365,6 +2060,7 @@ NOBDEF bool nob_proc_wait(Nob_Proc proc)
 
         if (WIFEXITED(wstatus)) {
             int exit_status = WEXITSTATUS(wstatus);
+            nob__proc_exited(proc, exit_status);
             if (exit_status != 0) {
                 nob_log(NOB_ERROR, "command exited with exit code %d", exit_status);
                 return false;
@@ -1374,6 +2070,7 @@ NOBDEF bool nob_proc_wait(Nob_Proc proc)
         }
 
         if (WIFSIGNALED(wstatus)) {
+            nob__proc_exited(proc, 128 + WTERMSIG(wstatus));
             nob_log(NOB_ERROR, "command process was terminated by signal %d", WTERMSIG(wstatus));
             return false;
         }
@@ -1407,6 +2104,7 @@ static int nob__proc_wait_async(Nob_Proc proc, int ms)
         nob_log(NOB_ERROR, "could not get process exit code: %s", nob_win32_error_message(GetLastError()));
         return -1;
     }
+    nob__proc_exited(proc, (int) exit_status);
 
     if (exit_status != 0) {
         nob_log(NOB_ERROR, "command exited with exit code %lu", exit_status);
@@ -1431,12 +2129,13 @@ static int nob__proc_wait_async(Nob_Proc proc, int ms)
     }
 
     if (pid == 0) {
-        nanosleep(&duration, NULL);
+        if (ms > 0) nanosleep(&duration, NULL);
         return 0;
     }
 
     if (WIFEXITED(wstatus)) {
         int exit_status = WEXITSTATUS(wstatus);
+        nob__proc_exited(proc, exit_status);
         if (exit_status != 0) {
             nob_log(NOB_ERROR, "command exited with exit code %d", exit_status);
             return -1;
@@ -1446,11 +2145,12 @@ static int nob__proc_wait_async(Nob_Proc proc, int ms)
     }
 
     if (WIFSIGNALED(wstatus)) {
+        nob__proc_exited(proc, 128 + WTERMSIG(wstatus));
         nob_log(NOB_ERROR, "command process was terminated by signal %d", WTERMSIG(wstatus));
         return -1;
     }
 
-    nanosleep(&duration, NULL);
+    if (ms > 0) nanosleep(&duration, NULL);
     return 0;
 #endif
 }
@@ -1644,12 +2344,60 @@ NOBDEF bool nob_delete_file(const char *path)
 #endif // _WIN32
 }
 
-NOBDEF bool nob_copy_directory_recursively(const char *src_path, const char *dst_path)
+typedef struct {
+    char **items; // source and destination of each file, one after the other
+    size_t count;
+    size_t capacity;
+} Nob__Copy_Jobs;
+
+static char *nob__heap_strdup(const char *cstr)
+{
+    size_t n = strlen(cstr) + 1;
+    char *copy = (char*)NOB_REALLOC(NULL, n);
+    NOB_ASSERT(copy != NULL && "Buy more RAM lol!!");
+    memcpy(copy, cstr, n);
+    return copy;
+}
+
+static char *nob__path_join(const char *dir, const char *name)
+{
+    size_t dir_len = strlen(dir), name_len = strlen(name);
+    char *path = (char*)NOB_REALLOC(NULL, dir_len + 1 + name_len + 1);
+    NOB_ASSERT(path != NULL && "Buy more RAM lol!!");
+    memcpy(path, dir, dir_len);
+    path[dir_len] = '/';
+    memcpy(path + dir_len + 1, name, name_len + 1);
+    return path;
+}
+
+#ifndef _WIN32
+static bool nob__copy_symlink(const char *src_path, const char *dst_path)
+{
+    char target[4096];
+    ssize_t n = readlink(src_path, target, sizeof(target) - 1);
+    if (n < 0) {
+        nob_log(NOB_ERROR, "Could not read link %s: %s", src_path, strerror(errno));
+        return false;
+    }
+    target[n] = '\0';
+    nob_log(NOB_INFO, "linking %s -> %s", dst_path, target);
+    if (unlink(dst_path) < 0 && errno != ENOENT) {
+        nob_log(NOB_ERROR, "Could not replace %s: %s", dst_path, strerror(errno));
+        return false;
+    }
+    if (symlink(target, dst_path) < 0) {
+        nob_log(NOB_ERROR, "Could not create link %s: %s", dst_path, strerror(errno));
+        return false;
+    }
+    return true;
+}
+#endif // _WIN32
+
+// Makes the directories of the tree and collects the files to copy into jobs
+static bool nob__plan_copy(const char *src_path, const char *dst_path, Nob__Copy_Jobs *jobs)
 {
     bool result = true;
     Nob_File_Paths children = {0};
-    Nob_String_Builder src_sb = {0};
-    Nob_String_Builder dst_sb = {0};
     size_t temp_checkpoint = nob_temp_save();
 
     Nob_File_Type type = nob_get_file_type(src_path);
@@ -1664,32 +2412,26 @@ NOBDEF bool nob_copy_directory_recursively(const char *src_path, const char *dst
                 if (strcmp(children.items[i], ".") == 0) continue;
                 if (strcmp(children.items[i], "..") == 0) continue;
 
-                src_sb.count = 0;
-                nob_sb_append_cstr(&src_sb, src_path);
-                nob_sb_append_cstr(&src_sb, "/");
-                nob_sb_append_cstr(&src_sb, children.items[i]);
-                nob_sb_append_null(&src_sb);
-
-                dst_sb.count = 0;
-                nob_sb_append_cstr(&dst_sb, dst_path);
-                nob_sb_append_cstr(&dst_sb, "/");
-                nob_sb_append_cstr(&dst_sb, children.items[i]);
-                nob_sb_append_null(&dst_sb);
-
-                if (!nob_copy_directory_recursively(src_sb.items, dst_sb.items)) {
-                    nob_return_defer(false);
-                }
+                char *src_child = nob__path_join(src_path, children.items[i]);
+                char *dst_child = nob__path_join(dst_path, children.items[i]);
+                bool ok = nob__plan_copy(src_child, dst_child, jobs);
+                NOB_FREE(src_child);
+                NOB_FREE(dst_child);
+                if (!ok) nob_return_defer(false);
             }
         } break;
 
         case NOB_FILE_REGULAR: {
-            if (!nob_copy_file(src_path, dst_path)) {
-                nob_return_defer(false);
-            }
+            nob_da_append(jobs, nob__heap_strdup(src_path));
+            nob_da_append(jobs, nob__heap_strdup(dst_path));
         } break;
 
         case NOB_FILE_SYMLINK: {
+#ifdef _WIN32
             nob_log(NOB_WARNING, "TODO: Copying symlinks is not supported yet");
+#else
+            if (!nob__copy_symlink(src_path, dst_path)) nob_return_defer(false);
+#endif // _WIN32
         } break;
 
         case NOB_FILE_OTHER: {
@@ -1702,12 +2444,188 @@ NOBDEF bool nob_copy_directory_recursively(const char *src_path, const char *dst
 
 defer:
     nob_temp_rewind(temp_checkpoint);
-    nob_da_free(src_sb);
-    nob_da_free(dst_sb);
     nob_da_free(children);
     return result;
 }
 
+#ifndef _WIN32
+typedef struct {
+    Nob__Copy_Jobs *jobs;
+    size_t next;      // the next file to copy
+    bool ok;
+    pthread_mutex_t lock;
+} Nob__Copy_Pool;
+
+static void *nob__copy_worker(void *arg)
+{
+    Nob__Copy_Pool *pool = (Nob__Copy_Pool*)arg;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        size_t i = pool->next++;
+        bool ok = pool->ok;
+        pthread_mutex_unlock(&pool->lock);
+        if (!ok || 2*i >= pool->jobs->count) return NULL;
+
+        if (!nob_copy_file(pool->jobs->items[2*i], pool->jobs->items[2*i + 1])) {
+            pthread_mutex_lock(&pool->lock);
+            pool->ok = false;
+            pthread_mutex_unlock(&pool->lock);
+        }
+    }
+}
+#endif // _WIN32
+
+NOBDEF bool nob_copy_directory_recursively(const char *src_path, const char *dst_path)
+{
+    Nob__Copy_Jobs jobs = {0};
+    bool result = nob__plan_copy(src_path, dst_path, &jobs);
+    size_t files = jobs.count/2;
+
+#ifdef _WIN32
+    for (size_t i = 0; result && i < files; ++i) {
+        result = nob_copy_file(jobs.items[2*i], jobs.items[2*i + 1]);
+    }
+#else
+    if (result && files > 0) {
+        Nob__Copy_Pool pool = {&jobs, 0, true, PTHREAD_MUTEX_INITIALIZER};
+        pthread_t threads[NOB_COPY_MAX_WORKERS];
+        size_t workers = (size_t) nob_nprocs();
+        if (workers > NOB_COPY_MAX_WORKERS) workers = NOB_COPY_MAX_WORKERS;
+        if (workers > files) workers = files;
+
+        // The calling thread is one of the workers
+        size_t started = 1;
+        for (; started < workers; ++started) {
+            if (pthread_create(&threads[started], NULL, nob__copy_worker, &pool) != 0) break;
+        }
+        nob__copy_worker(&pool);
+        for (size_t i = 1; i < started; ++i) pthread_join(threads[i], NULL);
+        pthread_mutex_destroy(&pool.lock);
+        result = pool.ok;
+    }
+#endif // _WIN32
+
+    for (size_t i = 0; i < jobs.count; ++i) NOB_FREE(jobs.items[i]);
+    nob_da_free(jobs);
+    return result;
+}
+
+NOBDEF Nob_Arena nob_arena_from_buffer(void *buffer, size_t capacity)
+{
+    Nob_Arena arena;
+    arena.data = (char*)buffer;
+    arena.capacity = buffer ? capacity : 0;
+    arena.size = 0;
+    return arena;
+}
+
+NOBDEF void *nob_arena_alloc(Nob_Arena *arena, size_t requested_size)
+{
+    size_t word_size = sizeof(uintptr_t);
+    size_t size = (requested_size + word_size - 1)/word_size*word_size;
+    if (size > arena->capacity - arena->size) return NULL;
+    void *result = &arena->data[arena->size];
+    arena->size += size;
+    return result;
+}
+
+NOBDEF char *nob_arena_strdup(Nob_Arena *arena, const char *cstr)
+{
+    size_t n = strlen(cstr);
+    char *result = (char*)nob_arena_alloc(arena, n + 1);
+    NOB_ASSERT(result != NULL && "Increase the capacity of the arena");
+    memcpy(result, cstr, n);
+    result[n] = '\0';
+    return result;
+}
+
+NOBDEF char *nob_arena_vsprintf(Nob_Arena *arena, const char *format, va_list args)
+{
+    va_list copy;
+    va_copy(copy, args);
+    int n = vsnprintf(NULL, 0, format, copy);
+    va_end(copy);
+
+    NOB_ASSERT(n >= 0);
+    char *result = (char*)nob_arena_alloc(arena, n + 1);
+    NOB_ASSERT(result != NULL && "Increase the capacity of the arena");
+    vsnprintf(result, n + 1, format, args);
+
+    return result;
+}
+
+NOBDEF char *nob_arena_sprintf(Nob_Arena *arena, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    char *result = nob_arena_vsprintf(arena, format, args);
+    va_end(args);
+    return result;
+}
+
+NOBDEF void nob_arena_reset(Nob_Arena *arena)
+{
+    arena->size = 0;
+}
+
+NOBDEF size_t nob_arena_save(Nob_Arena *arena)
+{
+    return arena->size;
+}
+
+NOBDEF void nob_arena_rewind(Nob_Arena *arena, size_t checkpoint)
+{
+    arena->size = checkpoint;
+}
+
+#ifdef NOB_TEMP_SINGLE_THREADED
+static char nob__temp_buffer[NOB_TEMP_CAPACITY] = {0};
+static Nob_Arena nob__temp_default = {nob__temp_buffer, NOB_TEMP_CAPACITY, 0};
+static Nob_Arena *nob__temp_current = &nob__temp_default;
+#else
+// NOTE: NOB_TEMP_CAPACITY is too big to live in the thread-local storage itself (it is carved out of
+// the thread's stack mapping by most runtimes), so each thread allocates its buffer on first use.
+static NOB_THREAD_LOCAL Nob_Arena nob__temp_default = {0};
+static NOB_THREAD_LOCAL Nob_Arena *nob__temp_current = NULL;
+#endif // NOB_TEMP_SINGLE_THREADED
+
+NOBDEF Nob_Arena *nob_temp_arena(void)
+{
+#ifndef NOB_TEMP_SINGLE_THREADED
+    if (nob__temp_current == NULL) {
+        if (nob__temp_default.data == NULL) {
+            void *buffer = NOB_REALLOC(NULL, NOB_TEMP_CAPACITY);
+            NOB_ASSERT(buffer != NULL && "Buy more RAM lol");
+            nob__temp_default = nob_arena_from_buffer(buffer, NOB_TEMP_CAPACITY);
+        }
+        nob__temp_current = &nob__temp_default;
+    }
+#endif // NOB_TEMP_SINGLE_THREADED
+    return nob__temp_current;
+}
+
+NOBDEF Nob_Arena *nob_temp_set_arena(Nob_Arena *arena)
+{
+    Nob_Arena *prev = nob__temp_current;
+#ifdef NOB_TEMP_SINGLE_THREADED
+    nob__temp_current = arena ? arena : &nob__temp_default;
+#else
+    // NULL lets nob_temp_arena() set the default up again on first use, so neither installing an arena
+    // nor restoring the default allocates a buffer the thread may never touch.
+    nob__temp_current = arena;
+#endif // NOB_TEMP_SINGLE_THREADED
+    return prev;
+}
+
+NOBDEF void nob_temp_release_thread_buffer(void)
+{
+#ifndef NOB_TEMP_SINGLE_THREADED
+    if (nob__temp_current == &nob__temp_default) nob__temp_current = NULL;
+    NOB_FREE(nob__temp_default.data);
+    memset(&nob__temp_default, 0, sizeof(nob__temp_default));
+#endif // NOB_TEMP_SINGLE_THREADED
+}
+
 NOBDEF char *nob_temp_strdup(const char *cstr)
 {
     size_t n = strlen(cstr);
@@ -1720,12 +2638,7 @@ NOBDEF char *nob_temp_strdup(const char *cstr)
 
 NOBDEF void *nob_temp_alloc(size_t requested_size)
 {
-    size_t word_size = sizeof(uintptr_t);
-    size_t size = (requested_size + word_size - 1)/word_size*word_size;
-    if (nob_temp_size + size > NOB_TEMP_CAPACITY) return NULL;
-    void *result = &nob_temp[nob_temp_size];
-    nob_temp_size += size;
-    return result;
+    return nob_arena_alloc(nob_temp_arena(), requested_size);
 }
 
 NOBDEF char *nob_temp_sprintf(const char *format, ...)
@@ -1738,7 +2651,6 @@ NOBDEF char *nob_temp_sprintf(const char *format, ...)
     NOB_ASSERT(n >= 0);
     char *result = (char*)nob_temp_alloc(n + 1);
     NOB_ASSERT(result != NULL && "Extend the size of the temporary allocator");
-    // TODO: use proper arenas for the temporary allocator;
     va_start(args, format);
     vsnprintf(result, n + 1, format, args);
     va_end(args);
@@ -1748,17 +2660,17 @@ NOBDEF char *nob_temp_sprintf(const char *format, ...)
 
 NOBDEF void nob_temp_reset(void)
 {
-    nob_temp_size = 0;
+    nob_arena_reset(nob_temp_arena());
 }
 
 NOBDEF size_t nob_temp_save(void)
 {
-    return nob_temp_size;
+    return nob_arena_save(nob_temp_arena());
 }
 
 NOBDEF void nob_temp_rewind(size_t checkpoint)
 {
-    nob_temp_size = checkpoint;
+    nob_arena_rewind(nob_temp_arena(), checkpoint);
 }
 
 NOBDEF const char *nob_temp_sv_to_cstr(Nob_String_View sv)
@@ -1910,6 +2822,85 @@ defer:
     return result;
 }
 
+NOBDEF bool nob_file_map(Nob_File_Map *map, const char *path, unsigned hints)
+{
+    Nob_String_Builder sb = {0};
+    bool result = true;
+
+    map->data = "";
+    map->count = 0;
+    map->mapped = false;
+
+#ifdef _WIN32
+    (void) hints;
+    (void) result;
+    if (!nob_read_entire_file(path, &sb)) return false;
+#else
+    struct stat st;
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        nob_log(NOB_ERROR, "Could not open file %s: %s", path, strerror(errno));
+        return false;
+    }
+
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        size_t size = (size_t) st.st_size;
+        void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data != MAP_FAILED) {
+            if (hints & NOB_FILE_MAP_SEQUENTIAL) posix_madvise(data, size, POSIX_MADV_SEQUENTIAL);
+            if (hints & NOB_FILE_MAP_WILLNEED) posix_madvise(data, size, POSIX_MADV_WILLNEED);
+#ifdef MADV_HUGEPAGE
+            if (hints & NOB_FILE_MAP_HUGE_PAGES) madvise(data, size, MADV_HUGEPAGE);
+#endif
+            map->data = (const char*)data;
+            map->count = size;
+            map->mapped = true;
+            nob_return_defer(true);
+        }
+    }
+
+    // A pipe, a file in /proc that claims to be empty, or one mmap() refused
+    for (;;) {
+        nob_da_reserve(&sb, sb.count + 64*1024);
+        ssize_t n = read(fd, sb.items + sb.count, sb.capacity - sb.count);
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            nob_log(NOB_ERROR, "Could not read file %s: %s", path, strerror(errno));
+            nob_sb_free(sb);
+            nob_return_defer(false);
+        }
+        if (n == 0) break;
+        sb.count += (size_t) n;
+    }
+
+defer:
+    close(fd);
+    if (!result || map->mapped) return result;
+#endif
+
+    if (sb.count > 0) {
+        map->data = sb.items;
+        map->count = sb.count;
+    } else {
+        nob_sb_free(sb);
+    }
+    return true;
+}
+
+NOBDEF void nob_file_unmap(Nob_File_Map *map)
+{
+    if (map->mapped) {
+#ifndef _WIN32
+        munmap((void *) map->data, map->count);
+#endif
+    } else if (map->count > 0) {
+        NOB_FREE((void *) map->data);
+    }
+    map->data = "";
+    map->count = 0;
+    map->mapped = false;
+}
+
 NOBDEF int nob_sb_appendf(Nob_String_Builder *sb, const char *fmt, ...)
 {
     va_list args;
@@ -2238,6 +3229,9 @@ NOBDEF int closedir(DIR *dirp)
         #define da_foreach nob_da_foreach
         #define String_Builder Nob_String_Builder
         #define read_entire_file nob_read_entire_file
+        #define File_Map Nob_File_Map
+        #define file_map nob_file_map
+        #define file_unmap nob_file_unmap
         #define sb_appendf nob_sb_appendf
         #define sb_append_buf nob_sb_append_buf
         #define sb_append_cstr nob_sb_append_cstr
@@ -2253,6 +3247,7 @@ NOBDEF int closedir(DIR *dirp)
         #define Procs Nob_Procs
         #define proc_wait nob_proc_wait
         #define procs_wait nob_procs_wait
+        #define procs_wait_any nob_procs_wait_any
         #define procs_wait_and_reset nob_procs_wait_and_reset
         #define procs_append_with_flush nob_procs_append_with_flush
         #define procs_flush nob_procs_flush
@@ -2273,6 +3268,18 @@ NOBDEF int closedir(DIR *dirp)
         #define cmd_run_sync_and_reset nob_cmd_run_sync_and_reset
         #define cmd_run_sync_redirect nob_cmd_run_sync_redirect
         #define cmd_run_sync_redirect_and_reset nob_cmd_run_sync_redirect_and_reset
+        #define Arena Nob_Arena
+        #define arena_from_buffer nob_arena_from_buffer
+        #define arena_alloc nob_arena_alloc
+        #define arena_strdup nob_arena_strdup
+        #define arena_sprintf nob_arena_sprintf
+        #define arena_vsprintf nob_arena_vsprintf
+        #define arena_reset nob_arena_reset
+        #define arena_save nob_arena_save
+        #define arena_rewind nob_arena_rewind
+        #define temp_arena nob_temp_arena
+        #define temp_set_arena nob_temp_set_arena
+        #define temp_release_thread_buffer nob_temp_release_thread_buffer
         #define temp_strdup nob_temp_strdup
         #define temp_alloc nob_temp_alloc
         #define temp_sprintf nob_temp_sprintf
@@ -2303,6 +3310,9 @@ NOBDEF int closedir(DIR *dirp)
         #define win32_error_message nob_win32_error_message
         #define nprocs nob_nprocs
         #define nanos_since_unspecified_epoch nob_nanos_since_unspecified_epoch
+        #define trace_begin nob_trace_begin
+        #define trace_end nob_trace_end
+        #define jobserver_serve nob_jobserver_serve
         #define NANOS_PER_SEC NOB_NANOS_PER_SEC
     #endif // NOB_STRIP_PREFIX
 #endif // NOB_STRIP_PREFIX_GUARD_
@@ -1,4 +1,4 @@
-// stb_c_lexer.h - v0.12 - public domain Sean Barrett 2013
+// stb_c_lexer.h - v0.19 - public domain Sean Barrett 2013
 // lexer for making little C-like languages with recursive-descent parsers
 //
 // This file provides both the interface and the implementation.
@@ -10,6 +10,14 @@
 // suffixes on integer constants are not handled (you can override this).
 //
 // History:
+//     0.19 STB_C_LEXER_REPL_PROFILE, STB_C_LEX_FIRST_CHAR_TABLE and STB_C_LEX_LITERALS_AS_ERRORS
+//     0.18 incremental line index for locations, stb_c_lexer_lines_init/set_lines
+//     0.17 atom table for identifiers, stb_c_lexer_atoms_init/set_atoms/intern
+//     0.16 STB_C_LEX_EXACT_NUMBERS parses numbers exactly and locale-free, without strtod/strtol
+//     0.15 resumable streaming interface, stb_c_lexer_stream_*
+//     0.14 STB_C_LEX_ZERO_COPY returns identifiers and plain strings as views into the input
+//     0.13 SSE2 scanning of whitespace, comments, identifiers, digits and strings
+//          (STB_C_LEX_USE_SIMD, STB_C_LEX_SIMD_AVX2)
 //     0.12 fix compilation bug for NUL support; better support separate inclusion
 //     0.11 fix clang static analysis warning
 //     0.10 fix warnings
@@ -45,6 +53,67 @@
 //   See end of file for license information.
 
 #ifdef STB_C_LEXER_IMPLEMENTATION
+#if defined(STB_C_LEXER_REPL_PROFILE) && !defined(STB_C_LEXER_DEFINITIONS)
+// #define STB_C_LEXER_REPL_PROFILE instead of copying the lines below to get a
+// lexer for line-oriented command languages, e.g.
+//
+//      DrawText "hello" 100 0x40 20 @ 0 0 255 255   # a comment
+//
+// identifiers, integers, double-quoted strings and single-character
+// punctuation; '#' discards the rest of the line. Everything else is
+// compiled out, and the first character of a token is classified by
+// one table lookup. Float and char literals are still recognized, as a
+// single CLEX_parse_error token each, so they are reported where they are.
+
+#if defined(Y) || defined(N)
+#error "Can only use stb_c_lexer in contexts where the preprocessor symbols 'Y' and 'N' are not defined"
+#endif
+
+#define STB_C_LEX_C_DECIMAL_INTS    Y
+#define STB_C_LEX_C_HEX_INTS        Y
+#define STB_C_LEX_C_OCTAL_INTS      Y
+#define STB_C_LEX_C_DECIMAL_FLOATS  N
+#define STB_C_LEX_C99_HEX_FLOATS    N
+#define STB_C_LEX_C_IDENTIFIERS     Y
+#define STB_C_LEX_C_DQ_STRINGS      Y
+#define STB_C_LEX_C_SQ_STRINGS      N
+#define STB_C_LEX_C_CHARS           N
+#define STB_C_LEX_C_COMMENTS        N
+#define STB_C_LEX_CPP_COMMENTS      N
+#define STB_C_LEX_C_COMPARISONS     N
+#define STB_C_LEX_C_LOGICAL         N
+#define STB_C_LEX_C_SHIFTS          N
+#define STB_C_LEX_C_INCREMENTS      N
+#define STB_C_LEX_C_ARROW           N
+#define STB_C_LEX_EQUAL_ARROW       N
+#define STB_C_LEX_C_BITWISEEQ       N
+#define STB_C_LEX_C_ARITHEQ         N
+
+#define STB_C_LEX_PARSE_SUFFIXES    N
+#define STB_C_LEX_DECIMAL_SUFFIXES  ""
+#define STB_C_LEX_HEX_SUFFIXES      ""
+#define STB_C_LEX_OCTAL_SUFFIXES    ""
+#define STB_C_LEX_FLOAT_SUFFIXES    ""
+
+#define STB_C_LEX_0_IS_EOF             N
+#define STB_C_LEX_INTEGERS_AS_DOUBLES  N
+#define STB_C_LEX_MULTILINE_DSTRINGS   N
+#define STB_C_LEX_MULTILINE_SSTRINGS   N
+#define STB_C_LEX_USE_STDLIB           Y   // unused, STB_C_LEX_EXACT_NUMBERS parses them
+#define STB_C_LEX_DOLLAR_IDENTIFIER    N
+#define STB_C_LEX_FLOAT_NO_DECIMAL     N
+
+#define STB_C_LEX_DEFINE_ALL_TOKEN_NAMES  N
+#define STB_C_LEX_DISCARD_PREPROCESSOR    Y   // '#' comments
+
+#ifndef STB_C_LEX_FIRST_CHAR_TABLE
+#define STB_C_LEX_FIRST_CHAR_TABLE  Y
+#endif
+#define STB_C_LEX_LITERALS_AS_ERRORS  Y
+
+#define STB_C_LEXER_DEFINITIONS
+#endif
+
 #ifndef STB_C_LEXER_DEFINITIONS
 // to change the default parsing rules, copy the following lines
 // into your C/C++ file *before* including this, and then replace
@@ -102,6 +171,22 @@
 
 //#define STB_C_LEX_ISWHITE(str)    ... // return length in bytes of whitespace characters if first char is whitespace
 
+//#define STB_C_LEX_USE_SIMD        Y     // scan runs of whitespace, comments, identifiers, digits and strings
+                                          // 16 bytes at a time with SSE2 when input_stream_end is given;
+                                          // Y unless defined (it may also be set from the command line)
+//#define STB_C_LEX_SIMD_AVX2             // scan 32 bytes at a time when compiled for AVX2; only pays off
+                                          // for inputs dominated by long comments and strings
+//#define STB_C_LEX_ZERO_COPY       N     // return identifiers and strings without escapes as views into the
+                                          // input (not 0-terminated); only escaped strings use string_store
+//#define STB_C_LEX_EXACT_NUMBERS   Y     // parse numbers with the built-in parser: locale-free, rounds floats
+                                          // exactly like strtod and saturates integers like strtol; takes
+                                          // precedence over STB_C_LEX_USE_STDLIB; Y unless defined
+//#define STB_C_LEX_FIRST_CHAR_TABLE N    // classify the first character of a token with a 256-entry table
+                                          // before the switch; N unless defined (Y in the REPL profile)
+//#define STB_C_LEX_LITERALS_AS_ERRORS N  // return a float or char literal that is configured out as one
+                                          // CLEX_parse_error token, not as the pieces it would split into;
+                                          // N unless defined (Y in the REPL profile)
+
 #define STB_C_LEXER_DEFINITIONS         // This line prevents the header file from replacing your definitions
 // --END--
 #endif
@@ -110,6 +195,39 @@
 #ifndef INCLUDE_STB_C_LEXER_H
 #define INCLUDE_STB_C_LEXER_H
 
+typedef struct
+{
+   // atom table variables
+   unsigned int *hashes;
+   int  *slots;
+   int  *offsets;
+   char *names;
+   int   slot_mask;
+   int   max_atoms;
+   int   names_length;
+   int   count;
+} stb_lex_atoms;
+
+typedef struct
+{
+   int offset;       // of the next char to scan
+   int line;         // line breaks before offset
+   int line_start;   // offset of the first char of the line offset is on
+   int pending;      // '\r' or '\n' that would join the line break just before offset, or 0
+} stb_lex_line_cursor;
+
+typedef struct
+{
+   // line index variables
+   int  *starts;     // offset of the first char of every stride-th line
+   int   capacity;
+   int   count;
+   int   stride;
+   stb_lex_line_cursor end;    // the lines before end.offset are indexed
+   stb_lex_line_cursor chunk;  // the start of the current chunk of a stream
+   stb_lex_line_cursor carry;  // the start of the carry buffer of a stream
+} stb_lex_lines;
+
 typedef struct
 {
    // lexer variables
@@ -118,6 +236,8 @@ typedef struct
    char *parse_point;
    char *string_storage;
    int   string_storage_len;
+   stb_lex_atoms *atoms;
+   stb_lex_lines *lines;
 
    // lexer parse location for error messages
    char *where_firstchar;
@@ -129,6 +249,7 @@ typedef struct
    long   int_number;
    char *string;
    int string_len;
+   int atom;
 } stb_lexer;
 
 typedef struct
@@ -137,6 +258,27 @@ typedef struct
    int line_offset;
 } stb_lex_location;
 
+typedef struct
+{
+   // token results, the same fields stb_c_lexer_get_token fills in
+   stb_lexer lexer;
+
+   // stream variables
+   char *chunk;
+   char *chunk_end;
+   char *chunk_base;    // where the current chunk was fed
+   int   chunk_offset;  // of chunk_base in the whole input
+   char *carry;
+   int   carry_offset;  // of the start of the carry buffer in the whole input
+   int   carry_len;
+   int   carry_skip;
+   int   carry_capacity;
+   char *string_store;
+   int   store_length;
+   int   state;
+   int   finished;
+} stb_lex_stream;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -148,6 +290,9 @@ extern void stb_c_lexer_init(stb_lexer *lexer, const char *input_stream, const c
 //   - input_stream_end points to the end of the file, or NULL if you use 0-for-EOF
 //   - string_store is storage the lexer can use for storing parsed strings and identifiers
 //   - store_length is the length of that storage
+//   With STB_C_LEX_ZERO_COPY, only strings containing escapes are stored, one after
+//   another, so each stays valid until the next init; input_stream_end - input_stream
+//   bytes of storage are always enough.
 
 extern int stb_c_lexer_get_token(stb_lexer *lexer);
 // this function returns non-zero if a token is parsed, or 0 if at EOF
@@ -156,12 +301,67 @@ extern int stb_c_lexer_get_token(stb_lexer *lexer);
 //   - lexer->real_number is a double constant value for CLEX_floatlit, or CLEX_intlit if STB_C_LEX_INTEGERS_AS_DOUBLES
 //   - lexer->int_number is an integer constant for CLEX_intlit if !STB_C_LEX_INTEGERS_AS_DOUBLES, or character for CLEX_charlit
 //   - lexer->string is a 0-terminated string for CLEX_dqstring or CLEX_sqstring or CLEX_identifier
+//     (with STB_C_LEX_ZERO_COPY it points into the input instead, unless the string had escapes,
+//     and only decoded strings are 0-terminated)
 //   - lexer->string_len is the byte length of lexer->string
 
+// memory for an atom table of max_atoms names with name_bytes of text in total
+#define STB_C_LEX_ATOMS_MEMORY(max_atoms, name_bytes) \
+   (16 + (max_atoms)*4*(sizeof(int) + sizeof(unsigned int)) + ((max_atoms)+1)*sizeof(int) + (name_bytes))
+
+extern void stb_c_lexer_atoms_init(stb_lex_atoms *atoms, char *memory, int memory_length, int max_atoms);
+// this function initializes a table that interns identifiers: each distinct name gets
+// a small integer, its atom, counting up from 0 in the order names are first seen
+//   Input:
+//   - memory, memory_length is storage for the table and the names, which lives as long
+//     as the table; STB_C_LEX_ATOMS_MEMORY gives the size to allocate
+
+extern void stb_c_lexer_set_atoms(stb_lexer *lexer, stb_lex_atoms *atoms);
+// this function makes the lexer intern every identifier into atoms (after stb_c_lexer_init,
+// or on stream->lexer after stb_c_lexer_stream_init);
+// the hash is computed once while the identifier is scanned, so code that switches on
+// atoms, or caches per-name lookups by atom, never hashes or compares the name again
+//   Output:
+//   - lexer->atom is the atom of a CLEX_id, or -1 if the table is full
+
+extern int stb_c_lexer_intern(stb_lex_atoms *atoms, const char *name, int length);
+// this function returns the atom of name, adding it if it's new, or -1 if the table is
+// full; interning keywords before lexing gives them known atoms 0, 1, 2...
+
+extern const char *stb_c_lexer_atom_name(const stb_lex_atoms *atoms, int atom, int *length);
+// this function returns the 0-terminated name of an atom, and its length if length != NULL
+
+extern void stb_c_lexer_stream_init(stb_lex_stream *stream, char *carry_buffer, int carry_length, char *string_store, int store_length);
+// this function initializes a lexer that takes its input in chunks of any size,
+// e.g. straight from read() into a ring buffer
+//   Input:
+//   - carry_buffer holds a token that straddles two chunks until it is complete;
+//     a token longer than carry_length-4 is a CLEX_parse_error (64 bytes is plenty
+//     unless long strings are expected)
+//   - string_store, store_length as for stb_c_lexer_init
+
+extern void stb_c_lexer_stream_feed(stb_lex_stream *stream, const char *chunk, const char *chunk_end);
+// this function gives the stream its next chunk; only call it after
+// stb_c_lexer_stream_get_token reported CLEX_need_more
+
+extern void stb_c_lexer_stream_finish(stb_lex_stream *stream);
+// this function marks the end of the input, after the last chunk was fed
+
+extern int stb_c_lexer_stream_get_token(stb_lex_stream *stream);
+// this function returns non-zero if a token is parsed, or 0 with
+//   - stream->lexer.token == CLEX_need_more when the chunk is used up; feed the next one
+//     (the old chunk may be reused right away, nothing unfinished points into it), or
+//   - stream->lexer.token == CLEX_eof at the end of the input
+// Comments and discarded preprocessor lines resume where the last chunk left off.
+// Token fields point into the current chunk, or into the carry buffer for a token
+// that straddled chunks, and stay valid until the next call; their locations come
+// from stb_c_lexer_stream_get_location.
+
 extern void stb_c_lexer_get_location(const stb_lexer *lexer, const char *where, stb_lex_location *loc);
-// this inefficient function returns the line number and character offset of a
-// given location in the file as returned by stb_lex_token. Because it's inefficient,
-// you should only call it for errors, not for every token.
+// this function returns the line number and character offset of a given location
+// in the file as returned by stb_lex_token. Without a line index it rescans the file
+// from the start, so you should only call it for errors, not for every token; with
+// one (stb_c_lexer_set_lines) it is a binary search.
 // For error messages of invalid tokens, you typically want the location of the start
 // of the token (which caused the token to be invalid). For bugs involving legit
 // tokens, you can report the first or the range.
@@ -169,6 +369,21 @@ extern void stb_c_lexer_get_location(const stb_lexer *lexer, const char *where,
 //    - loc->line_number is the line number in the file, counting from 1, of the location
 //    - loc->line_offset is the char-offset in the line, counting from 0, of the location
 
+extern void stb_c_lexer_lines_init(stb_lex_lines *lines, int *memory, int count);
+// this function initializes an index of line starts for one input; memory holds
+// count line starts. Once it's full the index keeps every second line start, then
+// every fourth and so on, and a lookup scans forward from the nearest one it kept.
+
+extern void stb_c_lexer_set_lines(stb_lexer *lexer, stb_lex_lines *lines);
+// this function makes stb_c_lexer_get_location use lines (after stb_c_lexer_init, or
+// on stream->lexer after stb_c_lexer_stream_init and before the first chunk). The
+// index grows lazily up to each location asked for, or for a stream by each chunk
+// as it is fed, so the whole input is scanned for line breaks only once.
+
+extern void stb_c_lexer_stream_get_location(const stb_lex_stream *stream, const char *where, stb_lex_location *loc);
+// this function is stb_c_lexer_get_location for the current token of a stream, which
+// needs a line index; without one, loc->line_number is 0
+
 
 #ifdef __cplusplus
 }
@@ -205,6 +420,7 @@ enum
    CLEX_arrow         ,
    CLEX_eqarrow       ,
    CLEX_shleq, CLEX_shreq,
+   CLEX_need_more     ,
 
    CLEX_first_unused_token
 
@@ -262,6 +478,52 @@ typedef long       stb__clex_int;
 #include <stdlib.h>
 #endif
 
+#ifndef STB_C_LEX_USE_SIMD
+#define STB_C_LEX_USE_SIMD  Y
+#endif
+
+#ifndef STB_C_LEX_ZERO_COPY
+#define STB_C_LEX_ZERO_COPY N
+#endif
+
+#if STB_C_LEX_ZERO_COPY(x)
+#define STB__clex_zero_copy
+#endif
+
+#ifndef STB_C_LEX_EXACT_NUMBERS
+#define STB_C_LEX_EXACT_NUMBERS Y
+#endif
+
+#if STB_C_LEX_EXACT_NUMBERS(x)
+#define STB__clex_exact_numbers
+#include <limits.h>
+#include <stdlib.h> // strtod, for the few long inputs it can't round by itself
+#endif
+
+#ifndef STB_C_LEX_FIRST_CHAR_TABLE
+#define STB_C_LEX_FIRST_CHAR_TABLE N
+#endif
+
+#if STB_C_LEX_FIRST_CHAR_TABLE(x)
+#define STB__clex_first_char_table
+#endif
+
+#ifndef STB_C_LEX_LITERALS_AS_ERRORS
+#define STB_C_LEX_LITERALS_AS_ERRORS N
+#endif
+
+#if STB_C_LEX_LITERALS_AS_ERRORS(x) && !STB_C_LEX_C_DECIMAL_FLOATS(x)
+#define STB__clex_float_errors
+#endif
+
+#if STB_C_LEX_LITERALS_AS_ERRORS(x) && !STB_C_LEX_C_CHARS(x)
+#define STB__clex_char_errors
+#endif
+
+#if STB_C_LEX_USE_SIMD(x) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define STB__clex_simd
+#endif
+
 // Now for the rest of the file we'll use the basic definition where
 // where Y expands to its contents and N expands to nothing
 #undef  Y
@@ -277,6 +539,121 @@ void stb_c_lexer_init(stb_lexer *lexer, const char *input_stream, const char *in
    lexer->parse_point = (char *) input_stream;
    lexer->string_storage = string_store;
    lexer->string_storage_len = store_length;
+   lexer->atoms = 0;
+   lexer->lines = 0;
+}
+
+// API function
+void stb_c_lexer_set_atoms(stb_lexer *lexer, stb_lex_atoms *atoms)
+{
+   lexer->atoms = atoms;
+}
+
+// API function
+void stb_c_lexer_lines_init(stb_lex_lines *lines, int *memory, int count)
+{
+   stb_lex_line_cursor start = { 0, 0, 0, 0 };
+   lines->starts = memory;
+   lines->capacity = memory ? count : 0;
+   lines->count = lines->capacity > 0;
+   lines->stride = 1;
+   if (lines->count)
+      lines->starts[0] = 0;
+   lines->end = lines->chunk = lines->carry = start;
+}
+
+// API function
+void stb_c_lexer_set_lines(stb_lexer *lexer, stb_lex_lines *lines)
+{
+   lexer->lines = lines;
+}
+
+static void stb__clex_add_line(stb_lex_lines *lines, int line, int start)
+{
+   if (lines->count == lines->capacity) {
+      // full, keep every other line start
+      int i;
+      for (i = 0; 2*i < lines->count; ++i)
+         lines->starts[i] = lines->starts[2*i];
+      lines->count = i;
+      lines->stride *= 2;
+      if (line != lines->count * lines->stride)
+         return;
+   }
+   lines->starts[lines->count++] = start;
+}
+
+// move the cursor c over text, which is at c->offset, up to offset end, counting
+// line breaks the way stb_c_lexer_get_location always has: "\n", "\r", "\r\n"
+// or "\n\r"; add the line starts to lines unless it's NULL
+static void stb__clex_scan_lines(stb_lex_lines *lines, stb_lex_line_cursor *c, const char *text, int end)
+{
+   const char *p = text, *e = text + (end - c->offset);
+   int base = c->offset;
+   if (p != e && c->pending) {
+      if (*p == c->pending) {
+         // the second half of a line break the last scan stopped in
+         c->line_start = base + 1;
+         if (lines && lines->count && (lines->count-1) * lines->stride == c->line)
+            lines->starts[lines->count-1] = c->line_start;
+         ++p;
+      }
+      c->pending = 0;
+   }
+   while (p != e) {
+      char ch = *p++;
+      if ((unsigned char) ch > '\r' || (ch != '\n' && ch != '\r'))
+         continue;
+      if (p == e)
+         c->pending = ch == '\n' ? '\r' : '\n';
+      else if (*p + ch == '\r' + '\n')
+         ++p;
+      c->line += 1;
+      c->line_start = base + (int) (p - text);
+      if (lines && c->line == lines->count * lines->stride)
+         stb__clex_add_line(lines, c->line, c->line_start);
+   }
+   c->offset = end;
+}
+
+// the cursor at the last line start the index kept at or before offset
+static stb_lex_line_cursor stb__clex_find_line(const stb_lex_lines *lines, int offset)
+{
+   stb_lex_line_cursor c;
+   int lo = 0, hi = lines->count;
+   while (hi - lo > 1) {
+      int mid = lo + (hi - lo) / 2;
+      if (lines->starts[mid] <= offset)
+         lo = mid;
+      else
+         hi = mid;
+   }
+   c.offset = c.line_start = lines->starts[lo];
+   c.line = lo * lines->stride;
+   c.pending = 0;
+   return c;
+}
+
+// the line and line start of offset; text is at the cursor start and holds what lies
+// between start and text_end, so it's where the scan goes when the index skips lines
+static stb_lex_line_cursor stb__clex_line_at(const stb_lex_lines *lines, int offset, stb_lex_line_cursor start, const char *text, const char *text_end)
+{
+   stb_lex_line_cursor c = stb__clex_find_line(lines, offset);
+   const char *q = text + (offset - start.offset);
+   if (lines->stride > 1) {
+      if (c.offset < start.offset)
+         c = start;
+      stb__clex_scan_lines(0, &c, text + (c.offset - start.offset), offset);
+   }
+   if (c.line_start < offset && q < text_end && (*q == '\n' || *q == '\r')) {
+      // the second half of "\r\n" or "\n\r" counts as the start of the next line
+      int joins = offset > start.offset ? q[-1] + *q == '\r' + '\n' : start.pending == *q;
+      if (joins) {
+         c.line += 1;
+         c.line_start = offset;
+      }
+   }
+   return c;
 }
 
 // API function
@@ -285,6 +662,17 @@ void stb_c_lexer_get_location(const stb_lexer *lexer, const char *where, stb_lex
    char *p = lexer->input_stream;
    int line_number = 1;
    int char_offset = 0;
+   stb_lex_lines *lines = lexer->lines;
+   if (lines && lines->count) {
+      stb_lex_line_cursor start = { 0, 0, 0, 0 }, c;
+      int offset = (int) (where - lexer->input_stream);
+      if (offset > lines->end.offset)
+         stb__clex_scan_lines(lines, &lines->end, lexer->input_stream + lines->end.offset, offset);
+      c = stb__clex_line_at(lines, offset, start, lexer->input_stream, lexer->eof ? lexer->eof : where+1);
+      loc->line_number = c.line + 1;
+      loc->line_offset = offset - c.line_start;
+      return;
+   }
    while (*p && p < where) {
       if (*p == '\n' || *p == '\r') {
          p += (p[0]+p[1] == '\r'+'\n' ? 2 : 1); // skip newline
@@ -329,6 +717,201 @@ static const char *stb__strchr(const char *str, int ch)
    return 0;
 }
 
+static int stb__clex_isident(int x)
+{
+   return (x >= 'a' && x <= 'z')
+       || (x >= 'A' && x <= 'Z')
+       || (x >= '0' && x <= '9') // allow digits in middle of identifier
+       || x == '_' || (unsigned char) x >= 128
+       STB_C_LEX_DOLLAR_IDENTIFIER( || x == '$' );
+}
+
+#ifdef _MSC_VER
+typedef unsigned __int64   stb__clex_u64;
+#else
+typedef unsigned long long stb__clex_u64;
+#endif
+
+// Scanning helpers. Each one returns the first byte at or after p that ends
+// the run it scans for, or eof. With a known eof they compare whole vectors
+// while at least one vector's worth of input is left and finish byte by
+// byte; with eof == NULL (0-terminated input) they only scan byte by byte,
+// because reading ahead could run past the terminator.
+#include <string.h>
+
+#ifdef STB__clex_simd
+#if defined(__AVX2__) && defined(STB_C_LEX_SIMD_AVX2)
+#include <immintrin.h>
+#define STB__CLEX_SIMD_WIDTH      32
+#define STB__CLEX_SIMD_ALL        0xffffffffu
+typedef __m256i stb__clex_vec;
+#define stb__clex_load(p)         _mm256_loadu_si256((const __m256i *) (p))
+#define stb__clex_store(p,v)      _mm256_storeu_si256((__m256i *) (p), v)
+#define stb__clex_set1(c)         _mm256_set1_epi8((char) (c))
+#define stb__clex_eq(a,b)         _mm256_cmpeq_epi8(a,b)
+#define stb__clex_lt(a,b)         _mm256_cmpgt_epi8(b,a)
+#define stb__clex_or(a,b)         _mm256_or_si256(a,b)
+#define stb__clex_and(a,b)        _mm256_and_si256(a,b)
+#define stb__clex_add(a,b)        _mm256_add_epi8(a,b)
+#define stb__clex_mask(a)         ((unsigned int) _mm256_movemask_epi8(a))
+#else
+#include <emmintrin.h>
+#define STB__CLEX_SIMD_WIDTH      16
+#define STB__CLEX_SIMD_ALL        0xffffu
+typedef __m128i stb__clex_vec;
+#define stb__clex_load(p)         _mm_loadu_si128((const __m128i *) (p))
+#define stb__clex_store(p,v)      _mm_storeu_si128((__m128i *) (p), v)
+#define stb__clex_set1(c)         _mm_set1_epi8((char) (c))
+#define stb__clex_eq(a,b)         _mm_cmpeq_epi8(a,b)
+#define stb__clex_lt(a,b)         _mm_cmplt_epi8(a,b)
+#define stb__clex_or(a,b)         _mm_or_si128(a,b)
+#define stb__clex_and(a,b)        _mm_and_si128(a,b)
+#define stb__clex_add(a,b)        _mm_add_epi8(a,b)
+#define stb__clex_mask(a)         ((unsigned int) _mm_movemask_epi8(a))
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+static int stb__clex_ctz(unsigned int x)
+{
+   unsigned long i;
+   _BitScanForward(&i, x);
+   return (int) i;
+}
+#else
+#define stb__clex_ctz(x)          __builtin_ctz(x)
+#endif
+
+// signed compares only, so ranges are tested by moving 'lo' to -128 first
+#define stb__clex_in_range(v,lo,n)  stb__clex_lt(stb__clex_add(v, stb__clex_set1(0x80 - (lo))), stb__clex_set1(0x80 + (n)))
+#endif // STB__clex_simd
+
+static char *stb__clex_skip_white(char *p, char *eof)
+{
+   #ifdef STB__clex_simd
+   if (eof) {
+      // most runs are a single space, which is cheaper to take by hand
+      while (p != eof && *p == ' ')
+         ++p;
+      while (eof - p >= STB__CLEX_SIMD_WIDTH) {
+         stb__clex_vec v = stb__clex_load(p);
+         stb__clex_vec white = stb__clex_or(stb__clex_or(stb__clex_eq(v, stb__clex_set1(' ')),
+                                                         stb__clex_eq(v, stb__clex_set1('\t'))),
+                                            stb__clex_or(stb__clex_in_range(v, '\n', 1),   // \n
+                                                         stb__clex_in_range(v, '\f', 2))); // \f \r
+         unsigned int m = stb__clex_mask(white) ^ STB__CLEX_SIMD_ALL;
+         if (m)
+            return p + stb__clex_ctz(m);
+         p += STB__CLEX_SIMD_WIDTH;
+      }
+   }
+   #endif
+   while (p != eof && stb__clex_iswhite(*p))
+      ++p;
+   return p;
+}
+
+static char *stb__clex_find_eol(char *p, char *eof)
+{
+   #ifdef STB__clex_simd
+   if (eof) {
+      while (eof - p >= STB__CLEX_SIMD_WIDTH) {
+         stb__clex_vec v = stb__clex_load(p);
+         unsigned int m = stb__clex_mask(stb__clex_or(stb__clex_eq(v, stb__clex_set1('\n')),
+                                                      stb__clex_eq(v, stb__clex_set1('\r'))));
+         if (m)
+            return p + stb__clex_ctz(m);
+         p += STB__CLEX_SIMD_WIDTH;
+      }
+   }
+   #endif
+   while (p != eof && *p != '\r' && *p != '\n')
+      ++p;
+   return p;
+}
+
+// returns the '*' of the closing "*/"
+static char *stb__clex_find_comment_end(char *p, char *eof)
+{
+   #ifdef STB__clex_simd
+   if (eof) {
+      while (eof - p > STB__CLEX_SIMD_WIDTH) {
+         stb__clex_vec star  = stb__clex_eq(stb__clex_load(p  ), stb__clex_set1('*'));
+         stb__clex_vec slash = stb__clex_eq(stb__clex_load(p+1), stb__clex_set1('/'));
+         unsigned int m = stb__clex_mask(stb__clex_and(star, slash));
+         if (m)
+            return p + stb__clex_ctz(m);
+         p += STB__CLEX_SIMD_WIDTH;
+      }
+   }
+   #endif
+   while (p != eof && (p[0] != '*' || p+1 == eof || p[1] != '/'))
+      ++p;
+   return p;
+}
+
+static char *stb__clex_skip_ident(char *p, char *eof)
+{
+   #ifdef STB__clex_simd
+   if (eof) {
+      while (eof - p >= STB__CLEX_SIMD_WIDTH) {
+         stb__clex_vec v = stb__clex_load(p);
+         stb__clex_vec ident = stb__clex_or(stb__clex_in_range(stb__clex_or(v, stb__clex_set1(0x20)), 'a', 26),
+                                            stb__clex_in_range(v, '0', 10));
+         ident = stb__clex_or(ident, stb__clex_or(stb__clex_eq(v, stb__clex_set1('_')),
+                                                  stb__clex_lt(v, stb__clex_set1(0)))); // >= 128 is UTF8 char
+         STB_C_LEX_DOLLAR_IDENTIFIER( ident = stb__clex_or(ident, stb__clex_eq(v, stb__clex_set1('$'))); )
+         {
+            unsigned int m = stb__clex_mask(ident) ^ STB__CLEX_SIMD_ALL;
+            if (m)
+               return p + stb__clex_ctz(m);
+         }
+         p += STB__CLEX_SIMD_WIDTH;
+      }
+   }
+   #endif
+   while (p != eof && stb__clex_isident(*p))
+      ++p;
+   return p;
+}
+
+static char *stb__clex_skip_digits(char *p, char *eof)
+{
+   #ifdef STB__clex_simd
+   if (eof) {
+      while (eof - p >= STB__CLEX_SIMD_WIDTH) {
+         unsigned int m = stb__clex_mask(stb__clex_in_range(stb__clex_load(p), '0', 10)) ^ STB__CLEX_SIMD_ALL;
+         if (m)
+            return p + stb__clex_ctz(m);
+         p += STB__CLEX_SIMD_WIDTH;
+      }
+   }
+   #endif
+   while (p != eof && *p >= '0' && *p <= '9')
+      ++p;
+   return p;
+}
+
+// finds the closing delimiter or the next escape of a string
+static char *stb__clex_find_string_stop(char *p, char *eof, char delim)
+{
+   #ifdef STB__clex_simd
+   if (eof) {
+      while (eof - p >= STB__CLEX_SIMD_WIDTH) {
+         stb__clex_vec v = stb__clex_load(p);
+         unsigned int m = stb__clex_mask(stb__clex_or(stb__clex_eq(v, stb__clex_set1(delim)),
+                                                      stb__clex_eq(v, stb__clex_set1('\\'))));
+         if (m)
+            return p + stb__clex_ctz(m);
+         p += STB__CLEX_SIMD_WIDTH;
+      }
+   }
+   #endif
+   while (p != eof && *p != delim && *p != '\\')
+      ++p;
+   return p;
+}
+
 // parse suffixes at the end of a number
 static int stb__clex_parse_suffixes(stb_lexer *lexer, long tokenid, char *start, char *cur, const char *suffixes)
 {
@@ -445,6 +1028,804 @@ static double stb__clex_parse_float(char *p, char **q)
 }
 #endif
 
+#ifdef STB__clex_exact_numbers
+// Exact number parsing. Nothing here depends on the locale or reads past eof.
+//
+// Integers accumulate 8 digits at a time (SWAR) and saturate at LONG_MAX like
+// strtol. Decimal floats keep up to 19 significant digits in a 64-bit w and a
+// power of ten e10; when both are small the double operation w*10^e10 is exact
+// (Clinger), otherwise the Eisel-Lemire algorithm multiplies w by the top 128
+// bits of 5^e10, which always rounds correctly for a w that holds every digit.
+// If digits were dropped and w and w+1 round differently, the literal goes to
+// strtod without its decimal point so the locale can't change its meaning.
+// Hex floats are exact in binary and only need rounding.
+
+#define stb__clex_isdigit(c)  ((unsigned) ((c) - '0') < 10)
+
+static int stb__clex_hexdigit(int c)
+{
+   if (c >= '0' && c <= '9') return c - '0';
+   if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+   if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+   return -1;
+}
+
+#if (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined(_M_X64) || defined(_M_IX86) || defined(_M_ARM64)
+#define STB__clex_swar
+// if the 8 bytes at p are all digits, stores their value and returns 1
+static int stb__clex_eight_digits(const char *p, stb__clex_u64 *value)
+{
+   stb__clex_u64 v;
+   memcpy(&v, p, 8);
+   if (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) != 0x3333333333333333ULL)
+      return 0;
+   v -= 0x3030303030303030ULL;
+   v = v*10 + (v >> 8);   // pairs of digits
+   *value = (((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+             (((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+   return 1;
+}
+#endif
+
+// digits of the given base at p, saturating like strtol
+static long stb__clex_parse_int(char *p, char *eof, int base, char **q)
+{
+   stb__clex_u64 n = 0;
+   int d, overflow = 0;
+   #ifdef STB__clex_swar
+   stb__clex_u64 eight;
+   if (base == 10)
+      while (eof - p >= 8 && n < 100000000000ULL && stb__clex_eight_digits(p, &eight)) {
+         n = n*100000000 + eight;
+         p += 8;
+      }
+   #endif
+   for (; p != eof && (d = stb__clex_hexdigit(*p)) >= 0 && d < base; ++p) {
+      if (n > ((stb__clex_u64) LONG_MAX - d) / base)
+         overflow = 1;
+      else
+         n = n*base + d;
+   }
+   *q = p;
+   return overflow ? LONG_MAX : (long) n;
+}
+
+static int stb__clex_clz64(stb__clex_u64 x)
+{
+   #if defined(__GNUC__) || defined(__clang__)
+   return __builtin_clzll(x);
+   #elif defined(_MSC_VER) && defined(_M_X64)
+   unsigned long i;
+   _BitScanReverse64(&i, x);
+   return 63 - (int) i;
+   #else
+   int n = 0;
+   while (!(x & 0x8000000000000000ULL)) { x <<= 1; ++n; }
+   return n;
+   #endif
+}
+
+// the low half of a*b, the high half goes to *hi
+static stb__clex_u64 stb__clex_mul128(stb__clex_u64 a, stb__clex_u64 b, stb__clex_u64 *hi)
+{
+   #if defined(__SIZEOF_INT128__)
+   __extension__ unsigned __int128 r = (unsigned __int128) a * b;
+   *hi = (stb__clex_u64) (r >> 64);
+   return (stb__clex_u64) r;
+   #elif defined(_MSC_VER) && defined(_M_X64)
+   return _umul128(a, b, hi);
+   #else
+   stb__clex_u64 a0 = a & 0xffffffff, a1 = a >> 32, b0 = b & 0xffffffff, b1 = b >> 32;
+   stb__clex_u64 p00 = a0*b0, p01 = a0*b1, p10 = a1*b0, p11 = a1*b1;
+   stb__clex_u64 mid = (p00 >> 32) + (p01 & 0xffffffff) + (p10 & 0xffffffff);
+   *hi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+   return (mid << 32) | (p00 & 0xffffffff);
+   #endif
+}
+
+static double stb__clex_double_from_bits(stb__clex_u64 bits)
+{
+   double d;
+   memcpy(&d, &bits, sizeof(d));
+   return d;
+}
+
+#define STB__CLEX_INFINITY_BITS  0x7FF0000000000000ULL
+
+// 128-bit truncations of 5^q for q in [-342,308], normalized to a leading 1 bit
+static const stb__clex_u64 stb__clex_pow5_128[] = {
+   0xeef453d6923bd65aULL,0x113faa2906a13b3fULL,0x9558b4661b6565f8ULL,0x4ac7ca59a424c507ULL,
+   0xbaaee17fa23ebf76ULL,0x5d79bcf00d2df649ULL,0xe95a99df8ace6f53ULL,0xf4d82c2c107973dcULL,
+   0x91d8a02bb6c10594ULL,0x79071b9b8a4be869ULL,0xb64ec836a47146f9ULL,0x9748e2826cdee284ULL,
+   0xe3e27a444d8d98b7ULL,0xfd1b1b2308169b25ULL,0x8e6d8c6ab0787f72ULL,0xfe30f0f5e50e20f7ULL,
+   0xb208ef855c969f4fULL,0xbdbd2d335e51a935ULL,0xde8b2b66b3bc4723ULL,0xad2c788035e61382ULL,
+   0x8b16fb203055ac76ULL,0x4c3bcb5021afcc31ULL,0xaddcb9e83c6b1793ULL,0xdf4abe242a1bbf3dULL,
+   0xd953e8624b85dd78ULL,0xd71d6dad34a2af0dULL,0x87d4713d6f33aa6bULL,0x8672648c40e5ad68ULL,
+   0xa9c98d8ccb009506ULL,0x680efdaf511f18c2ULL,0xd43bf0effdc0ba48ULL,0x0212bd1b2566def2ULL,
+   0x84a57695fe98746dULL,0x014bb630f7604b57ULL,0xa5ced43b7e3e9188ULL,0x419ea3bd35385e2dULL,
+   0xcf42894a5dce35eaULL,0x52064cac828675b9ULL,0x818995ce7aa0e1b2ULL,0x7343efebd1940993ULL,
+   0xa1ebfb4219491a1fULL,0x1014ebe6c5f90bf8ULL,0xca66fa129f9b60a6ULL,0xd41a26e077774ef6ULL,
+   0xfd00b897478238d0ULL,0x8920b098955522b4ULL,0x9e20735e8cb16382ULL,0x55b46e5f5d5535b0ULL,
+   0xc5a890362fddbc62ULL,0xeb2189f734aa831dULL,0xf712b443bbd52b7bULL,0xa5e9ec7501d523e4ULL,
+   0x9a6bb0aa55653b2dULL,0x47b233c92125366eULL,0xc1069cd4eabe89f8ULL,0x999ec0bb696e840aULL,
+   0xf148440a256e2c76ULL,0xc00670ea43ca250dULL,0x96cd2a865764dbcaULL,0x380406926a5e5728ULL,
+   0xbc807527ed3e12bcULL,0xc605083704f5ecf2ULL,0xeba09271e88d976bULL,0xf7864a44c633682eULL,
+   0x93445b8731587ea3ULL,0x7ab3ee6afbe0211dULL,0xb8157268fdae9e4cULL,0x5960ea05bad82964ULL,
+   0xe61acf033d1a45dfULL,0x6fb92487298e33bdULL,0x8fd0c16206306babULL,0xa5d3b6d479f8e056ULL,
+   0xb3c4f1ba87bc8696ULL,0x8f48a4899877186cULL,0xe0b62e2929aba83cULL,0x331acdabfe94de87ULL,
+   0x8c71dcd9ba0b4925ULL,0x9ff0c08b7f1d0b14ULL,0xaf8e5410288e1b6fULL,0x07ecf0ae5ee44dd9ULL,
+   0xdb71e91432b1a24aULL,0xc9e82cd9f69d6150ULL,0x892731ac9faf056eULL,0xbe311c083a225cd2ULL,
+   0xab70fe17c79ac6caULL,0x6dbd630a48aaf406ULL,0xd64d3d9db981787dULL,0x092cbbccdad5b108ULL,
+   0x85f0468293f0eb4eULL,0x25bbf56008c58ea5ULL,0xa76c582338ed2621ULL,0xaf2af2b80af6f24eULL,
+   0xd1476e2c07286faaULL,0x1af5af660db4aee1ULL,0x82cca4db847945caULL,0x50d98d9fc890ed4dULL,
+   0xa37fce126597973cULL,0xe50ff107bab528a0ULL,0xcc5fc196fefd7d0cULL,0x1e53ed49a96272c8ULL,
+   0xff77b1fcbebcdc4fULL,0x25e8e89c13bb0f7aULL,0x9faacf3df73609b1ULL,0x77b191618c54e9acULL,
+   0xc795830d75038c1dULL,0xd59df5b9ef6a2417ULL,0xf97ae3d0d2446f25ULL,0x4b0573286b44ad1dULL,
+   0x9becce62836ac577ULL,0x4ee367f9430aec32ULL,0xc2e801fb244576d5ULL,0x229c41f793cda73fULL,
+   0xf3a20279ed56d48aULL,0x6b43527578c1110fULL,0x9845418c345644d6ULL,0x830a13896b78aaa9ULL,
+   0xbe5691ef416bd60cULL,0x23cc986bc656d553ULL,0xedec366b11c6cb8fULL,0x2cbfbe86b7ec8aa8ULL,
+   0x94b3a202eb1c3f39ULL,0x7bf7d71432f3d6a9ULL,0xb9e08a83a5e34f07ULL,0xdaf5ccd93fb0cc53ULL,
+   0xe858ad248f5c22c9ULL,0xd1b3400f8f9cff68ULL,0x91376c36d99995beULL,0x23100809b9c21fa1ULL,
+   0xb58547448ffffb2dULL,0xabd40a0c2832a78aULL,0xe2e69915b3fff9f9ULL,0x16c90c8f323f516cULL,
+   0x8dd01fad907ffc3bULL,0xae3da7d97f6792e3ULL,0xb1442798f49ffb4aULL,0x99cd11cfdf41779cULL,
+   0xdd95317f31c7fa1dULL,0x40405643d711d583ULL,0x8a7d3eef7f1cfc52ULL,0x482835ea666b2572ULL,
+   0xad1c8eab5ee43b66ULL,0xda3243650005eecfULL,0xd863b256369d4a40ULL,0x90bed43e40076a82ULL,
+   0x873e4f75e2224e68ULL,0x5a7744a6e804a291ULL,0xa90de3535aaae202ULL,0x711515d0a205cb36ULL,
+   0xd3515c2831559a83ULL,0x0d5a5b44ca873e03ULL,0x8412d9991ed58091ULL,0xe858790afe9486c2ULL,
+   0xa5178fff668ae0b6ULL,0x626e974dbe39a872ULL,0xce5d73ff402d98e3ULL,0xfb0a3d212dc8128fULL,
+   0x80fa687f881c7f8eULL,0x7ce66634bc9d0b99ULL,0xa139029f6a239f72ULL,0x1c1fffc1ebc44e80ULL,
+   0xc987434744ac874eULL,0xa327ffb266b56220ULL,0xfbe9141915d7a922ULL,0x4bf1ff9f0062baa8ULL,
+   0x9d71ac8fada6c9b5ULL,0x6f773fc3603db4a9ULL,0xc4ce17b399107c22ULL,0xcb550fb4384d21d3ULL,
+   0xf6019da07f549b2bULL,0x7e2a53a146606a48ULL,0x99c102844f94e0fbULL,0x2eda7444cbfc426dULL,
+   0xc0314325637a1939ULL,0xfa911155fefb5308ULL,0xf03d93eebc589f88ULL,0x793555ab7eba27caULL,
+   0x96267c7535b763b5ULL,0x4bc1558b2f3458deULL,0xbbb01b9283253ca2ULL,0x9eb1aaedfb016f16ULL,
+   0xea9c227723ee8bcbULL,0x465e15a979c1cadcULL,0x92a1958a7675175fULL,0x0bfacd89ec191ec9ULL,
+   0xb749faed14125d36ULL,0xcef980ec671f667bULL,0xe51c79a85916f484ULL,0x82b7e12780e7401aULL,
+   0x8f31cc0937ae58d2ULL,0xd1b2ecb8b0908810ULL,0xb2fe3f0b8599ef07ULL,0x861fa7e6dcb4aa15ULL,
+   0xdfbdcece67006ac9ULL,0x67a791e093e1d49aULL,0x8bd6a141006042bdULL,0xe0c8bb2c5c6d24e0ULL,
+   0xaecc49914078536dULL,0x58fae9f773886e18ULL,0xda7f5bf590966848ULL,0xaf39a475506a899eULL,
+   0x888f99797a5e012dULL,0x6d8406c952429603ULL,0xaab37fd7d8f58178ULL,0xc8e5087ba6d33b83ULL,
+   0xd5605fcdcf32e1d6ULL,0xfb1e4a9a90880a64ULL,0x855c3be0a17fcd26ULL,0x5cf2eea09a55067fULL,
+   0xa6b34ad8c9dfc06fULL,0xf42faa48c0ea481eULL,0xd0601d8efc57b08bULL,0xf13b94daf124da26ULL,
+   0x823c12795db6ce57ULL,0x76c53d08d6b70858ULL,0xa2cb1717b52481edULL,0x54768c4b0c64ca6eULL,
+   0xcb7ddcdda26da268ULL,0xa9942f5dcf7dfd09ULL,0xfe5d54150b090b02ULL,0xd3f93b35435d7c4cULL,
+   0x9efa548d26e5a6e1ULL,0xc47bc5014a1a6dafULL,0xc6b8e9b0709f109aULL,0x359ab6419ca1091bULL,
+   0xf867241c8cc6d4c0ULL,0xc30163d203c94b62ULL,0x9b407691d7fc44f8ULL,0x79e0de63425dcf1dULL,
+   0xc21094364dfb5636ULL,0x985915fc12f542e4ULL,0xf294b943e17a2bc4ULL,0x3e6f5b7b17b2939dULL,
+   0x979cf3ca6cec5b5aULL,0xa705992ceecf9c42ULL,0xbd8430bd08277231ULL,0x50c6ff782a838353ULL,
+   0xece53cec4a314ebdULL,0xa4f8bf5635246428ULL,0x940f4613ae5ed136ULL,0x871b7795e136be99ULL,
+   0xb913179899f68584ULL,0x28e2557b59846e3fULL,0xe757dd7ec07426e5ULL,0x331aeada2fe589cfULL,
+   0x9096ea6f3848984fULL,0x3ff0d2c85def7621ULL,0xb4bca50b065abe63ULL,0x0fed077a756b53a9ULL,
+   0xe1ebce4dc7f16dfbULL,0xd3e8495912c62894ULL,0x8d3360f09cf6e4bdULL,0x64712dd7abbbd95cULL,
+   0xb080392cc4349decULL,0xbd8d794d96aacfb3ULL,0xdca04777f541c567ULL,0xecf0d7a0fc5583a0ULL,
+   0x89e42caaf9491b60ULL,0xf41686c49db57244ULL,0xac5d37d5b79b6239ULL,0x311c2875c522ced5ULL,
+   0xd77485cb25823ac7ULL,0x7d633293366b828bULL,0x86a8d39ef77164bcULL,0xae5dff9c02033197ULL,
+   0xa8530886b54dbdebULL,0xd9f57f830283fdfcULL,0xd267caa862a12d66ULL,0xd072df63c324fd7bULL,
+   0x8380dea93da4bc60ULL,0x4247cb9e59f71e6dULL,0xa46116538d0deb78ULL,0x52d9be85f074e608ULL,
+   0xcd795be870516656ULL,0x67902e276c921f8bULL,0x806bd9714632dff6ULL,0x00ba1cd8a3db53b6ULL,
+   0xa086cfcd97bf97f3ULL,0x80e8a40eccd228a4ULL,0xc8a883c0fdaf7df0ULL,0x6122cd128006b2cdULL,
+   0xfad2a4b13d1b5d6cULL,0x796b805720085f81ULL,0x9cc3a6eec6311a63ULL,0xcbe3303674053bb0ULL,
+   0xc3f490aa77bd60fcULL,0xbedbfc4411068a9cULL,0xf4f1b4d515acb93bULL,0xee92fb5515482d44ULL,
+   0x991711052d8bf3c5ULL,0x751bdd152d4d1c4aULL,0xbf5cd54678eef0b6ULL,0xd262d45a78a0635dULL,
+   0xef340a98172aace4ULL,0x86fb897116c87c34ULL,0x9580869f0e7aac0eULL,0xd45d35e6ae3d4da0ULL,
+   0xbae0a846d2195712ULL,0x8974836059cca109ULL,0xe998d258869facd7ULL,0x2bd1a438703fc94bULL,
+   0x91ff83775423cc06ULL,0x7b6306a34627ddcfULL,0xb67f6455292cbf08ULL,0x1a3bc84c17b1d542ULL,
+   0xe41f3d6a7377eecaULL,0x20caba5f1d9e4a93ULL,0x8e938662882af53eULL,0x547eb47b7282ee9cULL,
+   0xb23867fb2a35b28dULL,0xe99e619a4f23aa43ULL,0xdec681f9f4c31f31ULL,0x6405fa00e2ec94d4ULL,
+   0x8b3c113c38f9f37eULL,0xde83bc408dd3dd04ULL,0xae0b158b4738705eULL,0x9624ab50b148d445ULL,
+   0xd98ddaee19068c76ULL,0x3badd624dd9b0957ULL,0x87f8a8d4cfa417c9ULL,0xe54ca5d70a80e5d6ULL,
+   0xa9f6d30a038d1dbcULL,0x5e9fcf4ccd211f4cULL,0xd47487cc8470652bULL,0x7647c3200069671fULL,
+   0x84c8d4dfd2c63f3bULL,0x29ecd9f40041e073ULL,0xa5fb0a17c777cf09ULL,0xf468107100525890ULL,
+   0xcf79cc9db955c2ccULL,0x7182148d4066eeb4ULL,0x81ac1fe293d599bfULL,0xc6f14cd848405530ULL,
+   0xa21727db38cb002fULL,0xb8ada00e5a506a7cULL,0xca9cf1d206fdc03bULL,0xa6d90811f0e4851cULL,
+   0xfd442e4688bd304aULL,0x908f4a166d1da663ULL,0x9e4a9cec15763e2eULL,0x9a598e4e043287feULL,
+   0xc5dd44271ad3cdbaULL,0x40eff1e1853f29fdULL,0xf7549530e188c128ULL,0xd12bee59e68ef47cULL,
+   0x9a94dd3e8cf578b9ULL,0x82bb74f8301958ceULL,0xc13a148e3032d6e7ULL,0xe36a52363c1faf01ULL,
+   0xf18899b1bc3f8ca1ULL,0xdc44e6c3cb279ac1ULL,0x96f5600f15a7b7e5ULL,0x29ab103a5ef8c0b9ULL,
+   0xbcb2b812db11a5deULL,0x7415d448f6b6f0e7ULL,0xebdf661791d60f56ULL,0x111b495b3464ad21ULL,
+   0x936b9fcebb25c995ULL,0xcab10dd900beec34ULL,0xb84687c269ef3bfbULL,0x3d5d514f40eea742ULL,
+   0xe65829b3046b0afaULL,0x0cb4a5a3112a5112ULL,0x8ff71a0fe2c2e6dcULL,0x47f0e785eaba72abULL,
+   0xb3f4e093db73a093ULL,0x59ed216765690f56ULL,0xe0f218b8d25088b8ULL,0x306869c13ec3532cULL,
+   0x8c974f7383725573ULL,0x1e414218c73a13fbULL,0xafbd2350644eeacfULL,0xe5d1929ef90898faULL,
+   0xdbac6c247d62a583ULL,0xdf45f746b74abf39ULL,0x894bc396ce5da772ULL,0x6b8bba8c328eb783ULL,
+   0xab9eb47c81f5114fULL,0x066ea92f3f326564ULL,0xd686619ba27255a2ULL,0xc80a537b0efefebdULL,
+   0x8613fd0145877585ULL,0xbd06742ce95f5f36ULL,0xa798fc4196e952e7ULL,0x2c48113823b73704ULL,
+   0xd17f3b51fca3a7a0ULL,0xf75a15862ca504c5ULL,0x82ef85133de648c4ULL,0x9a984d73dbe722fbULL,
+   0xa3ab66580d5fdaf5ULL,0xc13e60d0d2e0ebbaULL,0xcc963fee10b7d1b3ULL,0x318df905079926a8ULL,
+   0xffbbcfe994e5c61fULL,0xfdf17746497f7052ULL,0x9fd561f1fd0f9bd3ULL,0xfeb6ea8bedefa633ULL,
+   0xc7caba6e7c5382c8ULL,0xfe64a52ee96b8fc0ULL,0xf9bd690a1b68637bULL,0x3dfdce7aa3c673b0ULL,
+   0x9c1661a651213e2dULL,0x06bea10ca65c084eULL,0xc31bfa0fe5698db8ULL,0x486e494fcff30a62ULL,
+   0xf3e2f893dec3f126ULL,0x5a89dba3c3efccfaULL,0x986ddb5c6b3a76b7ULL,0xf89629465a75e01cULL,
+   0xbe89523386091465ULL,0xf6bbb397f1135823ULL,0xee2ba6c0678b597fULL,0x746aa07ded582e2cULL,
+   0x94db483840b717efULL,0xa8c2a44eb4571cdcULL,0xba121a4650e4ddebULL,0x92f34d62616ce413ULL,
+   0xe896a0d7e51e1566ULL,0x77b020baf9c81d17ULL,0x915e2486ef32cd60ULL,0x0ace1474dc1d122eULL,
+   0xb5b5ada8aaff80b8ULL,0x0d819992132456baULL,0xe3231912d5bf60e6ULL,0x10e1fff697ed6c69ULL,
+   0x8df5efabc5979c8fULL,0xca8d3ffa1ef463c1ULL,0xb1736b96b6fd83b3ULL,0xbd308ff8a6b17cb2ULL,
+   0xddd0467c64bce4a0ULL,0xac7cb3f6d05ddbdeULL,0x8aa22c0dbef60ee4ULL,0x6bcdf07a423aa96bULL,
+   0xad4ab7112eb3929dULL,0x86c16c98d2c953c6ULL,0xd89d64d57a607744ULL,0xe871c7bf077ba8b7ULL,
+   0x87625f056c7c4a8bULL,0x11471cd764ad4972ULL,0xa93af6c6c79b5d2dULL,0xd598e40d3dd89bcfULL,
+   0xd389b47879823479ULL,0x4aff1d108d4ec2c3ULL,0x843610cb4bf160cbULL,0xcedf722a585139baULL,
+   0xa54394fe1eedb8feULL,0xc2974eb4ee658828ULL,0xce947a3da6a9273eULL,0x733d226229feea32ULL,
+   0x811ccc668829b887ULL,0x0806357d5a3f525fULL,0xa163ff802a3426a8ULL,0xca07c2dcb0cf26f7ULL,
+   0xc9bcff6034c13052ULL,0xfc89b393dd02f0b5ULL,0xfc2c3f3841f17c67ULL,0xbbac2078d443ace2ULL,
+   0x9d9ba7832936edc0ULL,0xd54b944b84aa4c0dULL,0xc5029163f384a931ULL,0x0a9e795e65d4df11ULL,
+   0xf64335bcf065d37dULL,0x4d4617b5ff4a16d5ULL,0x99ea0196163fa42eULL,0x504bced1bf8e4e45ULL,
+   0xc06481fb9bcf8d39ULL,0xe45ec2862f71e1d6ULL,0xf07da27a82c37088ULL,0x5d767327bb4e5a4cULL,
+   0x964e858c91ba2655ULL,0x3a6a07f8d510f86fULL,0xbbe226efb628afeaULL,0x890489f70a55368bULL,
+   0xeadab0aba3b2dbe5ULL,0x2b45ac74ccea842eULL,0x92c8ae6b464fc96fULL,0x3b0b8bc90012929dULL,
+   0xb77ada0617e3bbcbULL,0x09ce6ebb40173744ULL,0xe55990879ddcaabdULL,0xcc420a6a101d0515ULL,
+   0x8f57fa54c2a9eab6ULL,0x9fa946824a12232dULL,0xb32df8e9f3546564ULL,0x47939822dc96abf9ULL,
+   0xdff9772470297ebdULL,0x59787e2b93bc56f7ULL,0x8bfbea76c619ef36ULL,0x57eb4edb3c55b65aULL,
+   0xaefae51477a06b03ULL,0xede622920b6b23f1ULL,0xdab99e59958885c4ULL,0xe95fab368e45ecedULL,
+   0x88b402f7fd75539bULL,0x11dbcb0218ebb414ULL,0xaae103b5fcd2a881ULL,0xd652bdc29f26a119ULL,
+   0xd59944a37c0752a2ULL,0x4be76d3346f0495fULL,0x857fcae62d8493a5ULL,0x6f70a4400c562ddbULL,
+   0xa6dfbd9fb8e5b88eULL,0xcb4ccd500f6bb952ULL,0xd097ad07a71f26b2ULL,0x7e2000a41346a7a7ULL,
+   0x825ecc24c873782fULL,0x8ed400668c0c28c8ULL,0xa2f67f2dfa90563bULL,0x728900802f0f32faULL,
+   0xcbb41ef979346bcaULL,0x4f2b40a03ad2ffb9ULL,0xfea126b7d78186bcULL,0xe2f610c84987bfa8ULL,
+   0x9f24b832e6b0f436ULL,0x0dd9ca7d2df4d7c9ULL,0xc6ede63fa05d3143ULL,0x91503d1c79720dbbULL,
+   0xf8a95fcf88747d94ULL,0x75a44c6397ce912aULL,0x9b69dbe1b548ce7cULL,0xc986afbe3ee11abaULL,
+   0xc24452da229b021bULL,0xfbe85badce996168ULL,0xf2d56790ab41c2a2ULL,0xfae27299423fb9c3ULL,
+   0x97c560ba6b0919a5ULL,0xdccd879fc967d41aULL,0xbdb6b8e905cb600fULL,0x5400e987bbc1c920ULL,
+   0xed246723473e3813ULL,0x290123e9aab23b68ULL,0x9436c0760c86e30bULL,0xf9a0b6720aaf6521ULL,
+   0xb94470938fa89bceULL,0xf808e40e8d5b3e69ULL,0xe7958cb87392c2c2ULL,0xb60b1d1230b20e04ULL,
+   0x90bd77f3483bb9b9ULL,0xb1c6f22b5e6f48c2ULL,0xb4ecd5f01a4aa828ULL,0x1e38aeb6360b1af3ULL,
+   0xe2280b6c20dd5232ULL,0x25c6da63c38de1b0ULL,0x8d590723948a535fULL,0x579c487e5a38ad0eULL,
+   0xb0af48ec79ace837ULL,0x2d835a9df0c6d851ULL,0xdcdb1b2798182244ULL,0xf8e431456cf88e65ULL,
+   0x8a08f0f8bf0f156bULL,0x1b8e9ecb641b58ffULL,0xac8b2d36eed2dac5ULL,0xe272467e3d222f3fULL,
+   0xd7adf884aa879177ULL,0x5b0ed81dcc6abb0fULL,0x86ccbb52ea94baeaULL,0x98e947129fc2b4e9ULL,
+   0xa87fea27a539e9a5ULL,0x3f2398d747b36224ULL,0xd29fe4b18e88640eULL,0x8eec7f0d19a03aadULL,
+   0x83a3eeeef9153e89ULL,0x1953cf68300424acULL,0xa48ceaaab75a8e2bULL,0x5fa8c3423c052dd7ULL,
+   0xcdb02555653131b6ULL,0x3792f412cb06794dULL,0x808e17555f3ebf11ULL,0xe2bbd88bbee40bd0ULL,
+   0xa0b19d2ab70e6ed6ULL,0x5b6aceaeae9d0ec4ULL,0xc8de047564d20a8bULL,0xf245825a5a445275ULL,
+   0xfb158592be068d2eULL,0xeed6e2f0f0d56712ULL,0x9ced737bb6c4183dULL,0x55464dd69685606bULL,
+   0xc428d05aa4751e4cULL,0xaa97e14c3c26b886ULL,0xf53304714d9265dfULL,0xd53dd99f4b3066a8ULL,
+   0x993fe2c6d07b7fabULL,0xe546a8038efe4029ULL,0xbf8fdb78849a5f96ULL,0xde98520472bdd033ULL,
+   0xef73d256a5c0f77cULL,0x963e66858f6d4440ULL,0x95a8637627989aadULL,0xdde7001379a44aa8ULL,
+   0xbb127c53b17ec159ULL,0x5560c018580d5d52ULL,0xe9d71b689dde71afULL,0xaab8f01e6e10b4a6ULL,
+   0x9226712162ab070dULL,0xcab3961304ca70e8ULL,0xb6b00d69bb55c8d1ULL,0x3d607b97c5fd0d22ULL,
+   0xe45c10c42a2b3b05ULL,0x8cb89a7db77c506aULL,0x8eb98a7a9a5b04e3ULL,0x77f3608e92adb242ULL,
+   0xb267ed1940f1c61cULL,0x55f038b237591ed3ULL,0xdf01e85f912e37a3ULL,0x6b6c46dec52f6688ULL,
+   0x8b61313bbabce2c6ULL,0x2323ac4b3b3da015ULL,0xae397d8aa96c1b77ULL,0xabec975e0a0d081aULL,
+   0xd9c7dced53c72255ULL,0x96e7bd358c904a21ULL,0x881cea14545c7575ULL,0x7e50d64177da2e54ULL,
+   0xaa242499697392d2ULL,0xdde50bd1d5d0b9e9ULL,0xd4ad2dbfc3d07787ULL,0x955e4ec64b44e864ULL,
+   0x84ec3c97da624ab4ULL,0xbd5af13bef0b113eULL,0xa6274bbdd0fadd61ULL,0xecb1ad8aeacdd58eULL,
+   0xcfb11ead453994baULL,0x67de18eda5814af2ULL,0x81ceb32c4b43fcf4ULL,0x80eacf948770ced7ULL,
+   0xa2425ff75e14fc31ULL,0xa1258379a94d028dULL,0xcad2f7f5359a3b3eULL,0x096ee45813a04330ULL,
+   0xfd87b5f28300ca0dULL,0x8bca9d6e188853fcULL,0x9e74d1b791e07e48ULL,0x775ea264cf55347eULL,
+   0xc612062576589ddaULL,0x95364afe032a819eULL,0xf79687aed3eec551ULL,0x3a83ddbd83f52205ULL,
+   0x9abe14cd44753b52ULL,0xc4926a9672793543ULL,0xc16d9a0095928a27ULL,0x75b7053c0f178294ULL,
+   0xf1c90080baf72cb1ULL,0x5324c68b12dd6339ULL,0x971da05074da7beeULL,0xd3f6fc16ebca5e04ULL,
+   0xbce5086492111aeaULL,0x88f4bb1ca6bcf585ULL,0xec1e4a7db69561a5ULL,0x2b31e9e3d06c32e6ULL,
+   0x9392ee8e921d5d07ULL,0x3aff322e62439fd0ULL,0xb877aa3236a4b449ULL,0x09befeb9fad487c3ULL,
+   0xe69594bec44de15bULL,0x4c2ebe687989a9b4ULL,0x901d7cf73ab0acd9ULL,0x0f9d37014bf60a11ULL,
+   0xb424dc35095cd80fULL,0x538484c19ef38c95ULL,0xe12e13424bb40e13ULL,0x2865a5f206b06fbaULL,
+   0x8cbccc096f5088cbULL,0xf93f87b7442e45d4ULL,0xafebff0bcb24aafeULL,0xf78f69a51539d749ULL,
+   0xdbe6fecebdedd5beULL,0xb573440e5a884d1cULL,0x89705f4136b4a597ULL,0x31680a88f8953031ULL,
+   0xabcc77118461cefcULL,0xfdc20d2b36ba7c3eULL,0xd6bf94d5e57a42bcULL,0x3d32907604691b4dULL,
+   0x8637bd05af6c69b5ULL,0xa63f9a49c2c1b110ULL,0xa7c5ac471b478423ULL,0x0fcf80dc33721d54ULL,
+   0xd1b71758e219652bULL,0xd3c36113404ea4a9ULL,0x83126e978d4fdf3bULL,0x645a1cac083126eaULL,
+   0xa3d70a3d70a3d70aULL,0x3d70a3d70a3d70a4ULL,0xccccccccccccccccULL,0xcccccccccccccccdULL,
+   0x8000000000000000ULL,0x0000000000000000ULL,0xa000000000000000ULL,0x0000000000000000ULL,
+   0xc800000000000000ULL,0x0000000000000000ULL,0xfa00000000000000ULL,0x0000000000000000ULL,
+   0x9c40000000000000ULL,0x0000000000000000ULL,0xc350000000000000ULL,0x0000000000000000ULL,
+   0xf424000000000000ULL,0x0000000000000000ULL,0x9896800000000000ULL,0x0000000000000000ULL,
+   0xbebc200000000000ULL,0x0000000000000000ULL,0xee6b280000000000ULL,0x0000000000000000ULL,
+   0x9502f90000000000ULL,0x0000000000000000ULL,0xba43b74000000000ULL,0x0000000000000000ULL,
+   0xe8d4a51000000000ULL,0x0000000000000000ULL,0x9184e72a00000000ULL,0x0000000000000000ULL,
+   0xb5e620f480000000ULL,0x0000000000000000ULL,0xe35fa931a0000000ULL,0x0000000000000000ULL,
+   0x8e1bc9bf04000000ULL,0x0000000000000000ULL,0xb1a2bc2ec5000000ULL,0x0000000000000000ULL,
+   0xde0b6b3a76400000ULL,0x0000000000000000ULL,0x8ac7230489e80000ULL,0x0000000000000000ULL,
+   0xad78ebc5ac620000ULL,0x0000000000000000ULL,0xd8d726b7177a8000ULL,0x0000000000000000ULL,
+   0x878678326eac9000ULL,0x0000000000000000ULL,0xa968163f0a57b400ULL,0x0000000000000000ULL,
+   0xd3c21bcecceda100ULL,0x0000000000000000ULL,0x84595161401484a0ULL,0x0000000000000000ULL,
+   0xa56fa5b99019a5c8ULL,0x0000000000000000ULL,0xcecb8f27f4200f3aULL,0x0000000000000000ULL,
+   0x813f3978f8940984ULL,0x4000000000000000ULL,0xa18f07d736b90be5ULL,0x5000000000000000ULL,
+   0xc9f2c9cd04674edeULL,0xa400000000000000ULL,0xfc6f7c4045812296ULL,0x4d00000000000000ULL,
+   0x9dc5ada82b70b59dULL,0xf020000000000000ULL,0xc5371912364ce305ULL,0x6c28000000000000ULL,
+   0xf684df56c3e01bc6ULL,0xc732000000000000ULL,0x9a130b963a6c115cULL,0x3c7f400000000000ULL,
+   0xc097ce7bc90715b3ULL,0x4b9f100000000000ULL,0xf0bdc21abb48db20ULL,0x1e86d40000000000ULL,
+   0x96769950b50d88f4ULL,0x1314448000000000ULL,0xbc143fa4e250eb31ULL,0x17d955a000000000ULL,
+   0xeb194f8e1ae525fdULL,0x5dcfab0800000000ULL,0x92efd1b8d0cf37beULL,0x5aa1cae500000000ULL,
+   0xb7abc627050305adULL,0xf14a3d9e40000000ULL,0xe596b7b0c643c719ULL,0x6d9ccd05d0000000ULL,
+   0x8f7e32ce7bea5c6fULL,0xe4820023a2000000ULL,0xb35dbf821ae4f38bULL,0xdda2802c8a800000ULL,
+   0xe0352f62a19e306eULL,0xd50b2037ad200000ULL,0x8c213d9da502de45ULL,0x4526f422cc340000ULL,
+   0xaf298d050e4395d6ULL,0x9670b12b7f410000ULL,0xdaf3f04651d47b4cULL,0x3c0cdd765f114000ULL,
+   0x88d8762bf324cd0fULL,0xa5880a69fb6ac800ULL,0xab0e93b6efee0053ULL,0x8eea0d047a457a00ULL,
+   0xd5d238a4abe98068ULL,0x72a4904598d6d880ULL,0x85a36366eb71f041ULL,0x47a6da2b7f864750ULL,
+   0xa70c3c40a64e6c51ULL,0x999090b65f67d924ULL,0xd0cf4b50cfe20765ULL,0xfff4b4e3f741cf6dULL,
+   0x82818f1281ed449fULL,0xbff8f10e7a8921a4ULL,0xa321f2d7226895c7ULL,0xaff72d52192b6a0dULL,
+   0xcbea6f8ceb02bb39ULL,0x9bf4f8a69f764490ULL,0xfee50b7025c36a08ULL,0x02f236d04753d5b4ULL,
+   0x9f4f2726179a2245ULL,0x01d762422c946590ULL,0xc722f0ef9d80aad6ULL,0x424d3ad2b7b97ef5ULL,
+   0xf8ebad2b84e0d58bULL,0xd2e0898765a7deb2ULL,0x9b934c3b330c8577ULL,0x63cc55f49f88eb2fULL,
+   0xc2781f49ffcfa6d5ULL,0x3cbf6b71c76b25fbULL,0xf316271c7fc3908aULL,0x8bef464e3945ef7aULL,
+   0x97edd871cfda3a56ULL,0x97758bf0e3cbb5acULL,0xbde94e8e43d0c8ecULL,0x3d52eeed1cbea317ULL,
+   0xed63a231d4c4fb27ULL,0x4ca7aaa863ee4bddULL,0x945e455f24fb1cf8ULL,0x8fe8caa93e74ef6aULL,
+   0xb975d6b6ee39e436ULL,0xb3e2fd538e122b44ULL,0xe7d34c64a9c85d44ULL,0x60dbbca87196b616ULL,
+   0x90e40fbeea1d3a4aULL,0xbc8955e946fe31cdULL,0xb51d13aea4a488ddULL,0x6babab6398bdbe41ULL,
+   0xe264589a4dcdab14ULL,0xc696963c7eed2dd1ULL,0x8d7eb76070a08aecULL,0xfc1e1de5cf543ca2ULL,
+   0xb0de65388cc8ada8ULL,0x3b25a55f43294bcbULL,0xdd15fe86affad912ULL,0x49ef0eb713f39ebeULL,
+   0x8a2dbf142dfcc7abULL,0x6e3569326c784337ULL,0xacb92ed9397bf996ULL,0x49c2c37f07965404ULL,
+   0xd7e77a8f87daf7fbULL,0xdc33745ec97be906ULL,0x86f0ac99b4e8dafdULL,0x69a028bb3ded71a3ULL,
+   0xa8acd7c0222311bcULL,0xc40832ea0d68ce0cULL,0xd2d80db02aabd62bULL,0xf50a3fa490c30190ULL,
+   0x83c7088e1aab65dbULL,0x792667c6da79e0faULL,0xa4b8cab1a1563f52ULL,0x577001b891185938ULL,
+   0xcde6fd5e09abcf26ULL,0xed4c0226b55e6f86ULL,0x80b05e5ac60b6178ULL,0x544f8158315b05b4ULL,
+   0xa0dc75f1778e39d6ULL,0x696361ae3db1c721ULL,0xc913936dd571c84cULL,0x03bc3a19cd1e38e9ULL,
+   0xfb5878494ace3a5fULL,0x04ab48a04065c723ULL,0x9d174b2dcec0e47bULL,0x62eb0d64283f9c76ULL,
+   0xc45d1df942711d9aULL,0x3ba5d0bd324f8394ULL,0xf5746577930d6500ULL,0xca8f44ec7ee36479ULL,
+   0x9968bf6abbe85f20ULL,0x7e998b13cf4e1ecbULL,0xbfc2ef456ae276e8ULL,0x9e3fedd8c321a67eULL,
+   0xefb3ab16c59b14a2ULL,0xc5cfe94ef3ea101eULL,0x95d04aee3b80ece5ULL,0xbba1f1d158724a12ULL,
+   0xbb445da9ca61281fULL,0x2a8a6e45ae8edc97ULL,0xea1575143cf97226ULL,0xf52d09d71a3293bdULL,
+   0x924d692ca61be758ULL,0x593c2626705f9c56ULL,0xb6e0c377cfa2e12eULL,0x6f8b2fb00c77836cULL,
+   0xe498f455c38b997aULL,0x0b6dfb9c0f956447ULL,0x8edf98b59a373fecULL,0x4724bd4189bd5eacULL,
+   0xb2977ee300c50fe7ULL,0x58edec91ec2cb657ULL,0xdf3d5e9bc0f653e1ULL,0x2f2967b66737e3edULL,
+   0x8b865b215899f46cULL,0xbd79e0d20082ee74ULL,0xae67f1e9aec07187ULL,0xecd8590680a3aa11ULL,
+   0xda01ee641a708de9ULL,0xe80e6f4820cc9495ULL,0x884134fe908658b2ULL,0x3109058d147fdcddULL,
+   0xaa51823e34a7eedeULL,0xbd4b46f0599fd415ULL,0xd4e5e2cdc1d1ea96ULL,0x6c9e18ac7007c91aULL,
+   0x850fadc09923329eULL,0x03e2cf6bc604ddb0ULL,0xa6539930bf6bff45ULL,0x84db8346b786151cULL,
+   0xcfe87f7cef46ff16ULL,0xe612641865679a63ULL,0x81f14fae158c5f6eULL,0x4fcb7e8f3f60c07eULL,
+   0xa26da3999aef7749ULL,0xe3be5e330f38f09dULL,0xcb090c8001ab551cULL,0x5cadf5bfd3072cc5ULL,
+   0xfdcb4fa002162a63ULL,0x73d9732fc7c8f7f6ULL,0x9e9f11c4014dda7eULL,0x2867e7fddcdd9afaULL,
+   0xc646d63501a1511dULL,0xb281e1fd541501b8ULL,0xf7d88bc24209a565ULL,0x1f225a7ca91a4226ULL,
+   0x9ae757596946075fULL,0x3375788de9b06958ULL,0xc1a12d2fc3978937ULL,0x0052d6b1641c83aeULL,
+   0xf209787bb47d6b84ULL,0xc0678c5dbd23a49aULL,0x9745eb4d50ce6332ULL,0xf840b7ba963646e0ULL,
+   0xbd176620a501fbffULL,0xb650e5a93bc3d898ULL,0xec5d3fa8ce427affULL,0xa3e51f138ab4cebeULL,
+   0x93ba47c980e98cdfULL,0xc66f336c36b10137ULL,0xb8a8d9bbe123f017ULL,0xb80b0047445d4184ULL,
+   0xe6d3102ad96cec1dULL,0xa60dc059157491e5ULL,0x9043ea1ac7e41392ULL,0x87c89837ad68db2fULL,
+   0xb454e4a179dd1877ULL,0x29babe4598c311fbULL,0xe16a1dc9d8545e94ULL,0xf4296dd6fef3d67aULL,
+   0x8ce2529e2734bb1dULL,0x1899e4a65f58660cULL,0xb01ae745b101e9e4ULL,0x5ec05dcff72e7f8fULL,
+   0xdc21a1171d42645dULL,0x76707543f4fa1f73ULL,0x899504ae72497ebaULL,0x6a06494a791c53a8ULL,
+   0xabfa45da0edbde69ULL,0x0487db9d17636892ULL,0xd6f8d7509292d603ULL,0x45a9d2845d3c42b6ULL,
+   0x865b86925b9bc5c2ULL,0x0b8a2392ba45a9b2ULL,0xa7f26836f282b732ULL,0x8e6cac7768d7141eULL,
+   0xd1ef0244af2364ffULL,0x3207d795430cd926ULL,0x8335616aed761f1fULL,0x7f44e6bd49e807b8ULL,
+   0xa402b9c5a8d3a6e7ULL,0x5f16206c9c6209a6ULL,0xcd036837130890a1ULL,0x36dba887c37a8c0fULL,
+   0x802221226be55a64ULL,0xc2494954da2c9789ULL,0xa02aa96b06deb0fdULL,0xf2db9baa10b7bd6cULL,
+   0xc83553c5c8965d3dULL,0x6f92829494e5acc7ULL,0xfa42a8b73abbf48cULL,0xcb772339ba1f17f9ULL,
+   0x9c69a97284b578d7ULL,0xff2a760414536efbULL,0xc38413cf25e2d70dULL,0xfef5138519684abaULL,
+   0xf46518c2ef5b8cd1ULL,0x7eb258665fc25d69ULL,0x98bf2f79d5993802ULL,0xef2f773ffbd97a61ULL,
+   0xbeeefb584aff8603ULL,0xaafb550ffacfd8faULL,0xeeaaba2e5dbf6784ULL,0x95ba2a53f983cf38ULL,
+   0x952ab45cfa97a0b2ULL,0xdd945a747bf26183ULL,0xba756174393d88dfULL,0x94f971119aeef9e4ULL,
+   0xe912b9d1478ceb17ULL,0x7a37cd5601aab85dULL,0x91abb422ccb812eeULL,0xac62e055c10ab33aULL,
+   0xb616a12b7fe617aaULL,0x577b986b314d6009ULL,0xe39c49765fdf9d94ULL,0xed5a7e85fda0b80bULL,
+   0x8e41ade9fbebc27dULL,0x14588f13be847307ULL,0xb1d219647ae6b31cULL,0x596eb2d8ae258fc8ULL,
+   0xde469fbd99a05fe3ULL,0x6fca5f8ed9aef3bbULL,0x8aec23d680043beeULL,0x25de7bb9480d5854ULL,
+   0xada72ccc20054ae9ULL,0xaf561aa79a10ae6aULL,0xd910f7ff28069da4ULL,0x1b2ba1518094da04ULL,
+   0x87aa9aff79042286ULL,0x90fb44d2f05d0842ULL,0xa99541bf57452b28ULL,0x353a1607ac744a53ULL,
+   0xd3fa922f2d1675f2ULL,0x42889b8997915ce8ULL,0x847c9b5d7c2e09b7ULL,0x69956135febada11ULL,
+   0xa59bc234db398c25ULL,0x43fab9837e699095ULL,0xcf02b2c21207ef2eULL,0x94f967e45e03f4bbULL,
+   0x8161afb94b44f57dULL,0x1d1be0eebac278f5ULL,0xa1ba1ba79e1632dcULL,0x6462d92a69731732ULL,
+   0xca28a291859bbf93ULL,0x7d7b8f7503cfdcfeULL,0xfcb2cb35e702af78ULL,0x5cda735244c3d43eULL,
+   0x9defbf01b061adabULL,0x3a0888136afa64a7ULL,0xc56baec21c7a1916ULL,0x088aaa1845b8fdd0ULL,
+   0xf6c69a72a3989f5bULL,0x8aad549e57273d45ULL,0x9a3c2087a63f6399ULL,0x36ac54e2f678864bULL,
+   0xc0cb28a98fcf3c7fULL,0x84576a1bb416a7ddULL,0xf0fdf2d3f3c30b9fULL,0x656d44a2a11c51d5ULL,
+   0x969eb7c47859e743ULL,0x9f644ae5a4b1b325ULL,0xbc4665b596706114ULL,0x873d5d9f0dde1feeULL,
+   0xeb57ff22fc0c7959ULL,0xa90cb506d155a7eaULL,0x9316ff75dd87cbd8ULL,0x09a7f12442d588f2ULL,
+   0xb7dcbf5354e9beceULL,0x0c11ed6d538aeb2fULL,0xe5d3ef282a242e81ULL,0x8f1668c8a86da5faULL,
+   0x8fa475791a569d10ULL,0xf96e017d694487bcULL,0xb38d92d760ec4455ULL,0x37c981dcc395a9acULL,
+   0xe070f78d3927556aULL,0x85bbe253f47b1417ULL,0x8c469ab843b89562ULL,0x93956d7478ccec8eULL,
+   0xaf58416654a6babbULL,0x387ac8d1970027b2ULL,0xdb2e51bfe9d0696aULL,0x06997b05fcc0319eULL,
+   0x88fcf317f22241e2ULL,0x441fece3bdf81f03ULL,0xab3c2fddeeaad25aULL,0xd527e81cad7626c3ULL,
+   0xd60b3bd56a5586f1ULL,0x8a71e223d8d3b074ULL,0x85c7056562757456ULL,0xf6872d5667844e49ULL,
+   0xa738c6bebb12d16cULL,0xb428f8ac016561dbULL,0xd106f86e69d785c7ULL,0xe13336d701beba52ULL,
+   0x82a45b450226b39cULL,0xecc0024661173473ULL,0xa34d721642b06084ULL,0x27f002d7f95d0190ULL,
+   0xcc20ce9bd35c78a5ULL,0x31ec038df7b441f4ULL,0xff290242c83396ceULL,0x7e67047175a15271ULL,
+   0x9f79a169bd203e41ULL,0x0f0062c6e984d386ULL,0xc75809c42c684dd1ULL,0x52c07b78a3e60868ULL,
+   0xf92e0c3537826145ULL,0xa7709a56ccdf8a82ULL,0x9bbcc7a142b17ccbULL,0x88a66076400bb691ULL,
+   0xc2abf989935ddbfeULL,0x6acff893d00ea435ULL,0xf356f7ebf83552feULL,0x0583f6b8c4124d43ULL,
+   0x98165af37b2153deULL,0xc3727a337a8b704aULL,0xbe1bf1b059e9a8d6ULL,0x744f18c0592e4c5cULL,
+   0xeda2ee1c7064130cULL,0x1162def06f79df73ULL,0x9485d4d1c63e8be7ULL,0x8addcb5645ac2ba8ULL,
+   0xb9a74a0637ce2ee1ULL,0x6d953e2bd7173692ULL,0xe8111c87c5c1ba99ULL,0xc8fa8db6ccdd0437ULL,
+   0x910ab1d4db9914a0ULL,0x1d9c9892400a22a2ULL,0xb54d5e4a127f59c8ULL,0x2503beb6d00cab4bULL,
+   0xe2a0b5dc971f303aULL,0x2e44ae64840fd61dULL,0x8da471a9de737e24ULL,0x5ceaecfed289e5d2ULL,
+   0xb10d8e1456105dadULL,0x7425a83e872c5f47ULL,0xdd50f1996b947518ULL,0xd12f124e28f77719ULL,
+   0x8a5296ffe33cc92fULL,0x82bd6b70d99aaa6fULL,0xace73cbfdc0bfb7bULL,0x636cc64d1001550bULL,
+   0xd8210befd30efa5aULL,0x3c47f7e05401aa4eULL,0x8714a775e3e95c78ULL,0x65acfaec34810a71ULL,
+   0xa8d9d1535ce3b396ULL,0x7f1839a741a14d0dULL,0xd31045a8341ca07cULL,0x1ede48111209a050ULL,
+   0x83ea2b892091e44dULL,0x934aed0aab460432ULL,0xa4e4b66b68b65d60ULL,0xf81da84d5617853fULL,
+   0xce1de40642e3f4b9ULL,0x36251260ab9d668eULL,0x80d2ae83e9ce78f3ULL,0xc1d72b7c6b426019ULL,
+   0xa1075a24e4421730ULL,0xb24cf65b8612f81fULL,0xc94930ae1d529cfcULL,0xdee033f26797b627ULL,
+   0xfb9b7cd9a4a7443cULL,0x169840ef017da3b1ULL,0x9d412e0806e88aa5ULL,0x8e1f289560ee864eULL,
+   0xc491798a08a2ad4eULL,0xf1a6f2bab92a27e2ULL,0xf5b5d7ec8acb58a2ULL,0xae10af696774b1dbULL,
+   0x9991a6f3d6bf1765ULL,0xacca6da1e0a8ef29ULL,0xbff610b0cc6edd3fULL,0x17fd090a58d32af3ULL,
+   0xeff394dcff8a948eULL,0xddfc4b4cef07f5b0ULL,0x95f83d0a1fb69cd9ULL,0x4abdaf101564f98eULL,
+   0xbb764c4ca7a4440fULL,0x9d6d1ad41abe37f1ULL,0xea53df5fd18d5513ULL,0x84c86189216dc5edULL,
+   0x92746b9be2f8552cULL,0x32fd3cf5b4e49bb4ULL,0xb7118682dbb66a77ULL,0x3fbc8c33221dc2a1ULL,
+   0xe4d5e82392a40515ULL,0x0fabaf3feaa5334aULL,0x8f05b1163ba6832dULL,0x29cb4d87f2a7400eULL,
+   0xb2c71d5bca9023f8ULL,0x743e20e9ef511012ULL,0xdf78e4b2bd342cf6ULL,0x914da9246b255416ULL,
+   0x8bab8eefb6409c1aULL,0x1ad089b6c2f7548eULL,0xae9672aba3d0c320ULL,0xa184ac2473b529b1ULL,
+   0xda3c0f568cc4f3e8ULL,0xc9e5d72d90a2741eULL,0x8865899617fb1871ULL,0x7e2fa67c7a658892ULL,
+   0xaa7eebfb9df9de8dULL,0xddbb901b98feeab7ULL,0xd51ea6fa85785631ULL,0x552a74227f3ea565ULL,
+   0x8533285c936b35deULL,0xd53a88958f87275fULL,0xa67ff273b8460356ULL,0x8a892abaf368f137ULL,
+   0xd01fef10a657842cULL,0x2d2b7569b0432d85ULL,0x8213f56a67f6b29bULL,0x9c3b29620e29fc73ULL,
+   0xa298f2c501f45f42ULL,0x8349f3ba91b47b8fULL,0xcb3f2f7642717713ULL,0x241c70a936219a73ULL,
+   0xfe0efb53d30dd4d7ULL,0xed238cd383aa0110ULL,0x9ec95d1463e8a506ULL,0xf4363804324a40aaULL,
+   0xc67bb4597ce2ce48ULL,0xb143c6053edcd0d5ULL,0xf81aa16fdc1b81daULL,0xdd94b7868e94050aULL,
+   0x9b10a4e5e9913128ULL,0xca7cf2b4191c8326ULL,0xc1d4ce1f63f57d72ULL,0xfd1c2f611f63a3f0ULL,
+   0xf24a01a73cf2dccfULL,0xbc633b39673c8cecULL,0x976e41088617ca01ULL,0xd5be0503e085d813ULL,
+   0xbd49d14aa79dbc82ULL,0x4b2d8644d8a74e18ULL,0xec9c459d51852ba2ULL,0xddf8e7d60ed1219eULL,
+   0x93e1ab8252f33b45ULL,0xcabb90e5c942b503ULL,0xb8da1662e7b00a17ULL,0x3d6a751f3b936243ULL,
+   0xe7109bfba19c0c9dULL,0x0cc512670a783ad4ULL,0x906a617d450187e2ULL,0x27fb2b80668b24c5ULL,
+   0xb484f9dc9641e9daULL,0xb1f9f660802dedf6ULL,0xe1a63853bbd26451ULL,0x5e7873f8a0396973ULL,
+   0x8d07e33455637eb2ULL,0xdb0b487b6423e1e8ULL,0xb049dc016abc5e5fULL,0x91ce1a9a3d2cda62ULL,
+   0xdc5c5301c56b75f7ULL,0x7641a140cc7810fbULL,0x89b9b3e11b6329baULL,0xa9e904c87fcb0a9dULL,
+   0xac2820d9623bf429ULL,0x546345fa9fbdcd44ULL,0xd732290fbacaf133ULL,0xa97c177947ad4095ULL,
+   0x867f59a9d4bed6c0ULL,0x49ed8eabcccc485dULL,0xa81f301449ee8c70ULL,0x5c68f256bfff5a74ULL,
+   0xd226fc195c6a2f8cULL,0x73832eec6fff3111ULL,0x83585d8fd9c25db7ULL,0xc831fd53c5ff7eabULL,
+   0xa42e74f3d032f525ULL,0xba3e7ca8b77f5e55ULL,0xcd3a1230c43fb26fULL,0x28ce1bd2e55f35ebULL,
+   0x80444b5e7aa7cf85ULL,0x7980d163cf5b81b3ULL,0xa0555e361951c366ULL,0xd7e105bcc332621fULL,
+   0xc86ab5c39fa63440ULL,0x8dd9472bf3fefaa7ULL,0xfa856334878fc150ULL,0xb14f98f6f0feb951ULL,
+   0x9c935e00d4b9d8d2ULL,0x6ed1bf9a569f33d3ULL,0xc3b8358109e84f07ULL,0x0a862f80ec4700c8ULL,
+   0xf4a642e14c6262c8ULL,0xcd27bb612758c0faULL,0x98e7e9cccfbd7dbdULL,0x8038d51cb897789cULL,
+   0xbf21e44003acdd2cULL,0xe0470a63e6bd56c3ULL,0xeeea5d5004981478ULL,0x1858ccfce06cac74ULL,
+   0x95527a5202df0ccbULL,0x0f37801e0c43ebc8ULL,0xbaa718e68396cffdULL,0xd30560258f54e6baULL,
+   0xe950df20247c83fdULL,0x47c6b82ef32a2069ULL,0x91d28b7416cdd27eULL,0x4cdc331d57fa5441ULL,
+   0xb6472e511c81471dULL,0xe0133fe4adf8e952ULL,0xe3d8f9e563a198e5ULL,0x58180fddd97723a6ULL,
+   0x8e679c2f5e44ff8fULL,0x570f09eaa7ea7648ULL
+};
+
+// w*10^e10 correctly rounded, for w != 0
+static double stb__clex_decimal_to_double(stb__clex_u64 w, int e10)
+{
+   static const double powers[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+   };
+   stb__clex_u64 hi, lo, m;
+   int lz, upper, shift, e2;
+
+   #if !defined(__FLT_EVAL_METHOD__) || (__FLT_EVAL_METHOD__ >= 0 && __FLT_EVAL_METHOD__ != 2)
+   // both w and 10^|e10| are exact doubles, so one rounding gives the answer
+   // (unless doubles are evaluated in long double, method 2, or it's unknown, -1)
+   if (w <= (1ULL << 53) && e10 >= -22 && e10 <= 22)
+      return e10 < 0 ? (double) w / powers[-e10] : (double) w * powers[e10];
+   #endif
+   if (e10 < -342)
+      return 0;
+   if (e10 > 308)
+      return stb__clex_double_from_bits(STB__CLEX_INFINITY_BITS);
+
+   lz = stb__clex_clz64(w);
+   w <<= lz;
+   lo = stb__clex_mul128(w, stb__clex_pow5_128[2*(e10+342)], &hi);
+   if ((hi & 0x1FF) == 0x1FF) {
+      // the bits that decide the rounding could still carry, use the low half of 5^e10 too
+      stb__clex_u64 hi2;
+      stb__clex_mul128(w, stb__clex_pow5_128[2*(e10+342)+1], &hi2);
+      lo += hi2;
+      if (hi2 > lo)
+         ++hi;
+   }
+   upper = (int) (hi >> 63);
+   shift = upper + 9;
+   m = hi >> shift;                                           // 54 bits: the mantissa and a rounding bit
+   e2 = (((152170 + 65536) * e10) >> 16) + 63 + upper - lz + 1023; // floor(e10*log2(10)) + ..., biased
+
+   if (e2 <= 0) {
+      // subnormal
+      if (1 - e2 >= 64)
+         return 0;
+      m >>= 1 - e2;
+      m += m & 1;
+      m >>= 1;
+      e2 = m < (1ULL << 52) ? 0 : 1;
+      return stb__clex_double_from_bits(m | ((stb__clex_u64) e2 << 52));
+   }
+   // exactly halfway is only possible for small e10; round that to even
+   if (lo <= 1 && e10 >= -4 && e10 <= 23 && (m & 3) == 1 && (m << shift) == hi)
+      m &= ~1ULL;
+   m += m & 1;
+   m >>= 1;
+   if (m >= (2ULL << 52)) {
+      m = 1ULL << 52;
+      ++e2;
+   }
+   if (e2 >= 0x7FF)
+      return stb__clex_double_from_bits(STB__CLEX_INFINITY_BITS);
+   return stb__clex_double_from_bits((m & ~(1ULL << 52)) | ((stb__clex_u64) e2 << 52));
+}
+
+// an [eE] or [pP] exponent: only taken if digits follow, like strtod does
+static char *stb__clex_parse_exponent(char *p, char *eof, int *exponent)
+{
+   char *e = p+1;
+   int negative = 0, n = 0;
+   if (e != eof && (*e == '+' || *e == '-'))
+      negative = *e++ == '-';
+   if (e == eof || !stb__clex_isdigit(*e))
+      return p;
+   for (; e != eof && stb__clex_isdigit(*e); ++e)
+      if (n < 100000)
+         n = n*10 + (*e - '0');
+   *exponent = negative ? -n : n;
+   return e;
+}
+
+// the literal from p to end without its decimal point, through strtod
+static double stb__clex_strtod_digits(char *p, char *end)
+{
+   // 767 significant digits decide any double, past that only "more than zero" matters
+   char buffer[800 + 16], *out = buffer;
+   int e10 = 0, exponent = 0, fraction = 0, dropped = 0;
+   while (p != end && (*p == '0' || *p == '.')) {
+      if (*p == '.') fraction = 1;
+      else if (fraction) --e10;
+      ++p;
+   }
+   for (; p != end && (stb__clex_isdigit(*p) || *p == '.'); ++p) {
+      if (*p == '.') {
+         fraction = 1;
+      } else if (out - buffer < 800) {
+         *out++ = *p;
+         e10 -= fraction;
+      } else {
+         e10 += !fraction;
+         dropped |= *p != '0';
+      }
+   }
+   if (dropped) {
+      *out++ = '1';
+      --e10;
+   }
+   if (p != end)
+      stb__clex_parse_exponent(p, end, &exponent);
+   e10 += exponent;
+   *out++ = 'e';
+   if (e10 < 0) {
+      *out++ = '-';
+      e10 = -e10;
+   }
+   {
+      char digits[12];
+      int n = 0;
+      do digits[n++] = (char) ('0' + e10 % 10); while (e10 /= 10);
+      while (n) *out++ = digits[--n];
+   }
+   *out = 0;
+   return strtod(buffer, NULL);
+}
+
+static double stb__clex_parse_decimal(char *p, char *eof, char **q)
+{
+   char *start = p;
+   stb__clex_u64 w = 0;
+   int digits = 0, e10 = 0, exponent = 0, truncated = 0;
+   #ifdef STB__clex_swar
+   stb__clex_u64 eight;
+   #endif
+
+   while (p != eof && *p == '0')
+      ++p;
+   #ifdef STB__clex_swar
+   while (digits <= 11 && eof - p >= 8 && stb__clex_eight_digits(p, &eight)) {
+      w = w*100000000 + eight;
+      digits += 8;
+      p += 8;
+   }
+   #endif
+   for (; p != eof && stb__clex_isdigit(*p); ++p) {
+      if (digits < 19) {
+         w = w*10 + (*p - '0');
+         ++digits;
+      } else {
+         ++e10;
+         truncated |= *p != '0';
+      }
+   }
+
+   if (p != eof && *p == '.') {
+      ++p;
+      if (digits == 0)
+         for (; p != eof && *p == '0'; ++p)
+            --e10;
+      #ifdef STB__clex_swar
+      while (digits <= 11 && eof - p >= 8 && stb__clex_eight_digits(p, &eight)) {
+         w = w*100000000 + eight;
+         digits += 8;
+         e10 -= 8;
+         p += 8;
+      }
+      #endif
+      for (; p != eof && stb__clex_isdigit(*p); ++p) {
+         if (digits < 19) {
+            w = w*10 + (*p - '0');
+            ++digits;
+            --e10;
+         } else {
+            truncated |= *p != '0';
+         }
+      }
+   }
+
+   if (p != eof && (*p == 'e' || *p == 'E'))
+      p = stb__clex_parse_exponent(p, eof, &exponent);
+   *q = p;
+
+   if (w == 0)
+      return 0;
+   e10 += exponent;
+   if (truncated) {
+      // the value is between w and w+1 (times 10^e10); if both ends agree, so does it
+      double d = stb__clex_decimal_to_double(w, e10);
+      if (d != stb__clex_decimal_to_double(w+1, e10))
+         d = stb__clex_strtod_digits(start, p);
+      return d;
+   }
+   return stb__clex_decimal_to_double(w, e10);
+}
+
+#ifdef STB__clex_hex_floats
+// m*2^e2 rounded to nearest even, for m != 0; sticky says nonzero bits below m were dropped
+static double stb__clex_make_double(stb__clex_u64 m, int e2, int sticky)
+{
+   int lz = stb__clex_clz64(m);
+   int exponent = e2 + 63 - lz + 1023; // biased exponent of the leading bit
+   int shift = 11;
+   stb__clex_u64 mantissa, rest, half, bits;
+
+   m <<= lz;
+   if (exponent >= 0x7FF)
+      return stb__clex_double_from_bits(STB__CLEX_INFINITY_BITS);
+   if (exponent < 1) {
+      // subnormal, fewer bits are kept
+      shift += 1 - exponent;
+      exponent = 1;
+   }
+   if (shift > 64)
+      return 0;
+   if (shift == 64) {
+      mantissa = 0;
+      rest = m;
+   } else {
+      mantissa = m >> shift;
+      rest = m & ((1ULL << shift) - 1);
+   }
+   half = 1ULL << (shift - 1);
+   if (rest > half || (rest == half && (sticky || (mantissa & 1))))
+      ++mantissa;
+   // a mantissa that rounded up to the next power of two carries into the exponent
+   bits = ((stb__clex_u64) (exponent - 1) << 52) + mantissa;
+   if (bits >= STB__CLEX_INFINITY_BITS)
+      bits = STB__CLEX_INFINITY_BITS;
+   return stb__clex_double_from_bits(bits);
+}
+
+static double stb__clex_parse_hex_float(char *p, char *eof, char **q)
+{
+   char *start = p;
+   stb__clex_u64 m = 0;
+   int e2 = 0, exponent = 0, sticky = 0, any = 0, d;
+
+   for (p += 2; p != eof && (d = stb__clex_hexdigit(*p)) >= 0; ++p, any = 1) {
+      if (m >> 60 == 0) {
+         m = m*16 + d;
+      } else {
+         e2 += 4;
+         sticky |= d;
+      }
+   }
+   if (p != eof && *p == '.') {
+      for (++p; p != eof && (d = stb__clex_hexdigit(*p)) >= 0; ++p, any = 1) {
+         if (m >> 60 == 0) {
+            m = m*16 + d;
+            e2 -= 4;
+         } else {
+            sticky |= d;
+         }
+      }
+   }
+   if (!any) {
+      // just the "0", as strtod reads it
+      *q = start+1;
+      return 0;
+   }
+   if (p != eof && (*p == 'p' || *p == 'P'))
+      p = stb__clex_parse_exponent(p, eof, &exponent);
+   *q = p;
+   if (m == 0)
+      return 0;
+   return stb__clex_make_double(m, e2 + exponent, sticky);
+}
+#endif // STB__clex_hex_floats
+#endif // STB__clex_exact_numbers
+
+// Atoms: open addressing with linear probing over at least twice as many
+// slots as atoms, so a probe always finds a free slot. Names are stored one
+// after another, 0-terminated; offsets[i] .. offsets[i+1]-1 is atom i's name.
+
+// 8 bytes at a time; the identifier is still in cache from being scanned
+static unsigned int stb__clex_hash(const char *p, int n)
+{
+   stb__clex_u64 h = (stb__clex_u64) n * 0x9E3779B97F4A7C15ULL, w;
+   for (; n >= 8; p += 8, n -= 8) {
+      memcpy(&w, p, 8);
+      h = (h ^ w) * 0xbf58476d1ce4e5b9ULL;
+      h ^= h >> 32;
+   }
+   if (n > 0) {
+      w = 0;
+      memcpy(&w, p, n);
+      h = (h ^ w) * 0xbf58476d1ce4e5b9ULL;
+   }
+   h ^= h >> 29;
+   h *= 0x94d049bb133111ebULL;
+   return (unsigned int) (h ^ (h >> 32));
+}
+
+// API function
+void stb_c_lexer_atoms_init(stb_lex_atoms *atoms, char *memory, int memory_length, int max_atoms)
+{
+   char *end = memory + memory_length;
+   int slot_count = 1;
+   char *p;
+
+   for (;;) {
+      slot_count = 1;
+      while (slot_count < 2*max_atoms)
+         slot_count *= 2;
+      p = memory + ((16 - ((size_t) memory & 15)) & 15);
+      p += slot_count * (sizeof(int) + sizeof(unsigned int)) + (max_atoms+1) * sizeof(int);
+      if (p <= end || max_atoms == 0)
+         break;
+      max_atoms /= 2; // doesn't fit, settle for fewer
+   }
+
+   p = memory + ((16 - ((size_t) memory & 15)) & 15);
+   atoms->hashes = (unsigned int *) p;
+   p += slot_count * sizeof(unsigned int);
+   atoms->slots = (int *) p;
+   p += slot_count * sizeof(int);
+   atoms->offsets = (int *) p;
+   p += (max_atoms+1) * sizeof(int);
+   atoms->names = p;
+   atoms->names_length = p < end ? (int) (end - p) : 0;
+   atoms->slot_mask = slot_count - 1;
+   atoms->max_atoms = p <= end ? max_atoms : 0;
+   atoms->count = 0;
+   if (atoms->max_atoms) {
+      memset(atoms->slots, 0xff, slot_count * sizeof(int));
+      atoms->offsets[0] = 0;
+   }
+}
+
+static int stb__clex_intern(stb_lex_atoms *atoms, const char *name, int length, unsigned int hash)
+{
+   int i = (int) (hash & (unsigned int) atoms->slot_mask);
+   int atom;
+
+   if (atoms->max_atoms == 0)
+      return -1;
+   while ((atom = atoms->slots[i]) >= 0) {
+      if (atoms->hashes[i] == hash
+          && atoms->offsets[atom+1] - atoms->offsets[atom] - 1 == length
+          && memcmp(atoms->names + atoms->offsets[atom], name, length) == 0)
+         return atom;
+      i = (i+1) & atoms->slot_mask;
+   }
+
+   if (atoms->count == atoms->max_atoms || atoms->offsets[atoms->count] + length + 1 > atoms->names_length)
+      return -1;
+   atom = atoms->count++;
+   memcpy(atoms->names + atoms->offsets[atom], name, length);
+   atoms->names[atoms->offsets[atom] + length] = 0;
+   atoms->offsets[atom+1] = atoms->offsets[atom] + length + 1;
+   atoms->slots[i] = atom;
+   atoms->hashes[i] = hash;
+   return atom;
+}
+
+// API function
+int stb_c_lexer_intern(stb_lex_atoms *atoms, const char *name, int length)
+{
+   return stb__clex_intern(atoms, name, length, stb__clex_hash(name, length));
+}
+
+// API function
+const char *stb_c_lexer_atom_name(const stb_lex_atoms *atoms, int atom, int *length)
+{
+   if (length)
+      *length = atoms->offsets[atom+1] - atoms->offsets[atom] - 1;
+   return atoms->names + atoms->offsets[atom];
+}
+
 static int stb__clex_parse_char(char *p, char **q)
 {
    if (*p == '\\') {
@@ -472,19 +1853,42 @@ static int stb__clex_parse_string(stb_lexer *lexer, char *p, int type)
    char delim = *p++; // grab the " or ' for later matching
    char *out = lexer->string_storage;
    char *outend = lexer->string_storage + lexer->string_storage_len;
-   while (*p != delim) {
+
+   #ifdef STB__clex_zero_copy
+   {
+      // without escapes the string is returned in place
+      char *stop = stb__clex_find_string_stop(p, lexer->eof, delim);
+      if (stop != lexer->eof && *stop == delim) {
+         lexer->string = p;
+         lexer->string_len = (int) (stop - p);
+         return stb__clex_token(lexer, type, start, stop);
+      }
+   }
+   #endif
+
+   for (;;) {
       int n;
-      if (*p == '\\') {
-         char *q;
-         n = stb__clex_parse_char(p, &q);
-         if (n < 0)
-            return stb__clex_token(lexer, CLEX_parse_error, start, q);
-         p = q;
-      } else {
-         // @OPTIMIZE: could speed this up by looping-while-not-backslash
-         n = (unsigned char) *p++;
+      // copy everything up to the delimiter or the next escape in one go,
+      // keeping a byte of storage for the terminator
+      char *stop = stb__clex_find_string_stop(p, lexer->eof, delim);
+      if (stop - p >= outend - out) {
+         char *last = outend - out > 0 ? p + (outend - out) : p;
+         return stb__clex_token(lexer, CLEX_parse_error, start, last);
       }
-      if (out+1 > outend)
+      memcpy(out, p, stop - p);
+      out += stop - p;
+      p = stop;
+      if (p == lexer->eof)
+         return stb__clex_token(lexer, CLEX_parse_error, start, p-1);
+      if (*p == delim)
+         break;
+
+      if (p+1 == lexer->eof) // a backslash right before eof
+         return stb__clex_token(lexer, CLEX_parse_error, start, p);
+      n = stb__clex_parse_char(p, &p);
+      if (n < 0)
+         return stb__clex_token(lexer, CLEX_parse_error, start, p);
+      if (out+1 >= outend)
          return stb__clex_token(lexer, CLEX_parse_error, start, p);
       // @TODO expand unicode escapes to UTF8
       *out++ = (char) n;
@@ -492,9 +1896,16 @@ static int stb__clex_parse_string(stb_lexer *lexer, char *p, int type)
    *out = 0;
    lexer->string = lexer->string_storage;
    lexer->string_len = (int) (out - lexer->string_storage);
+   #ifdef STB__clex_zero_copy
+   // keep the decoded string, the next one goes after it
+   lexer->string_storage += lexer->string_len + 1;
+   lexer->string_storage_len -= lexer->string_len + 1;
+   #endif
    return stb__clex_token(lexer, type, start, p);
 }
 
+static int stb__clex_lex_token(stb_lexer *lexer, char *p);
+
 int stb_c_lexer_get_token(stb_lexer *lexer)
 {
    char *p = lexer->parse_point;
@@ -511,24 +1922,20 @@ int stb_c_lexer_get_token(stb_lexer *lexer)
          p += n;
       }
       #else
-      while (p != lexer->eof && stb__clex_iswhite(*p))
-         ++p;
+      p = stb__clex_skip_white(p, lexer->eof);
       #endif
 
       STB_C_LEX_CPP_COMMENTS(
-         if (p != lexer->eof && p[0] == '/' && p[1] == '/') {
-            while (p != lexer->eof && *p != '\r' && *p != '\n')
-               ++p;
+         if (p != lexer->eof && p+1 != lexer->eof && p[0] == '/' && p[1] == '/') {
+            p = stb__clex_find_eol(p+2, lexer->eof);
             continue;
          }
       )
 
       STB_C_LEX_C_COMMENTS(
-         if (p != lexer->eof && p[0] == '/' && p[1] == '*') {
+         if (p != lexer->eof && p+1 != lexer->eof && p[0] == '/' && p[1] == '*') {
             char *start = p;
-            p += 2;
-            while (p != lexer->eof && (p[0] != '*' || p[1] != '/'))
-               ++p;
+            p = stb__clex_find_comment_end(p+2, lexer->eof);
             if (p == lexer->eof)
                return stb__clex_token(lexer, CLEX_parse_error, start, p-1);
             p += 2;
@@ -542,8 +1949,7 @@ int stb_c_lexer_get_token(stb_lexer *lexer)
          // be at the start. (because this parser doesn't otherwise
          // check for line breaks!)
          if (p != lexer->eof && p[0] == '#') {
-            while (p != lexer->eof && *p != '\r' && *p != '\n')
-               ++p;
+            p = stb__clex_find_eol(p+1, lexer->eof);
             continue;
          }
       #endif
@@ -554,31 +1960,241 @@ int stb_c_lexer_get_token(stb_lexer *lexer)
    if (p == lexer->eof)
       return stb__clex_eof(lexer);
 
+   return stb__clex_lex_token(lexer, p);
+}
+
+static int stb__clex_lex_ident(stb_lexer *lexer, char *p)
+{
+   int n = (int) (stb__clex_skip_ident(p+1, lexer->eof) - p);
+   #ifdef STB__clex_zero_copy
+   lexer->string = p;
+   #else
+   if (n >= lexer->string_storage_len)
+      return stb__clex_token(lexer, CLEX_parse_error, p, p + (lexer->string_storage_len > 0 ? lexer->string_storage_len-1 : 0));
+   lexer->string = lexer->string_storage;
+   #ifdef STB__clex_simd
+   // short identifiers are copied as one vector, saving the call
+   if (n <= STB__CLEX_SIMD_WIDTH && lexer->string_storage_len > STB__CLEX_SIMD_WIDTH && lexer->eof - p >= STB__CLEX_SIMD_WIDTH)
+      stb__clex_store(lexer->string, stb__clex_load(p));
+   else
+   #endif
+   memcpy(lexer->string, p, n);
+   lexer->string[n] = 0;
+   #endif
+   lexer->string_len = n;
+   if (lexer->atoms)
+      lexer->atom = stb__clex_intern(lexer->atoms, p, n, stb__clex_hash(p, n));
+   return stb__clex_token(lexer, CLEX_id, p, p+n-1);
+}
+
+// lex the number that starts at p, a digit
+static int stb__clex_lex_number(stb_lexer *lexer, char *p)
+{
+   #if defined(STB__clex_hex_ints) || defined(STB__clex_hex_floats)
+      if (p[0] == '0' && p+1 != lexer->eof) {
+         if (p[1] == 'x' || p[1] == 'X') {
+            char *q;
+
+            #ifdef STB__clex_hex_floats
+            for (q=p+2;
+                 q != lexer->eof && ((*q >= '0' && *q <= '9') || (*q >= 'a' && *q <= 'f') || (*q >= 'A' && *q <= 'F'));
+                 ++q);
+            if (q != lexer->eof) {
+               if (*q == '.' STB_C_LEX_FLOAT_NO_DECIMAL(|| *q == 'p' || *q == 'P')) {
+                  #if defined(STB__clex_exact_numbers)
+                  lexer->real_number = stb__clex_parse_hex_float(p, lexer->eof, &q);
+                  #elif defined(STB__CLEX_use_stdlib)
+                  lexer->real_number = strtod((char *) p, (char**) &q);
+                  #else
+                  lexer->real_number = stb__clex_parse_float(p, &q);
+                  #endif
+
+                  if (p == q)
+                     return stb__clex_token(lexer, CLEX_parse_error, p,q);
+                  return stb__clex_parse_suffixes(lexer, CLEX_floatlit, p,q, STB_C_LEX_FLOAT_SUFFIXES);
+
+               }
+            }
+            #endif   // STB__CLEX_hex_floats
+
+            #ifdef STB__clex_hex_ints
+            #if defined(STB__clex_exact_numbers)
+            lexer->int_number = stb__clex_parse_int(p+2, lexer->eof, 16, &q);
+            if (q == p+2) // like strtol, "0x" without digits is the 0 and an 'x'
+               q = p+1;
+            #elif defined(STB__CLEX_use_stdlib)
+            lexer->int_number = strtol((char *) p, (char **) &q, 16);
+            #else
+            {
+               stb__clex_int n=0;
+               for (q=p+2; q != lexer->eof; ++q) {
+                  if (*q >= '0' && *q <= '9')
+                     n = n*16 + (*q - '0');
+                  else if (*q >= 'a' && *q <= 'f')
+                     n = n*16 + (*q - 'a') + 10;
+                  else if (*q >= 'A' && *q <= 'F')
+                     n = n*16 + (*q - 'A') + 10;
+                  else
+                     break;
+               }
+               lexer->int_number = n;
+            }
+            #endif
+            if (q == p+2)
+               return stb__clex_token(lexer, CLEX_parse_error, p-2,p-1);
+            return stb__clex_parse_suffixes(lexer, CLEX_intlit, p,q, STB_C_LEX_HEX_SUFFIXES);
+            #endif
+         }
+      }
+   #endif // defined(STB__clex_hex_ints) || defined(STB__clex_hex_floats)
+   // can't test for octal because we might parse '0.0' as float or as '0' '.' '0',
+   // so have to do float first
+
+   #ifdef STB__clex_decimal_floats
+   {
+      char *q = stb__clex_skip_digits(p, lexer->eof);
+      if (q != lexer->eof) {
+         if (*q == '.' STB_C_LEX_FLOAT_NO_DECIMAL(|| *q == 'e' || *q == 'E')) {
+            #if defined(STB__clex_exact_numbers)
+            lexer->real_number = stb__clex_parse_decimal(p, lexer->eof, &q);
+            #elif defined(STB__CLEX_use_stdlib)
+            lexer->real_number = strtod((char *) p, (char**) &q);
+            #else
+            lexer->real_number = stb__clex_parse_float(p, &q);
+            #endif
+
+            return stb__clex_parse_suffixes(lexer, CLEX_floatlit, p,q, STB_C_LEX_FLOAT_SUFFIXES);
+
+         }
+      }
+   }
+   #elif defined(STB__clex_float_errors)
+   {
+      // the extent of "[0-9]+(.[0-9]*)?([eE][-+]?[0-9]+)?", without parsing it
+      char *q = stb__clex_skip_digits(p, lexer->eof);
+      if (q != lexer->eof && (*q == '.' || *q == 'e' || *q == 'E')) {
+         if (*q == '.')
+            q = stb__clex_skip_digits(q+1, lexer->eof);
+         if (q != lexer->eof && (*q == 'e' || *q == 'E')) {
+            char *e = q+1;
+            if (e != lexer->eof && (*e == '+' || *e == '-'))
+               ++e;
+            if (e != lexer->eof && *e >= '0' && *e <= '9')
+               q = stb__clex_skip_digits(e, lexer->eof);
+         }
+         return stb__clex_token(lexer, CLEX_parse_error, p, q-1);
+      }
+   }
+   #endif // STB__clex_decimal_floats
+
+   #ifdef STB__clex_octal_ints
+   if (p[0] == '0') {
+      char *q = p;
+      #if defined(STB__clex_exact_numbers)
+      lexer->int_number = stb__clex_parse_int(p, lexer->eof, 8, &q);
+      #elif defined(STB__CLEX_use_stdlib)
+      lexer->int_number = strtol((char *) p, (char **) &q, 8);
+      #else
+      stb__clex_int n=0;
+      while (q != lexer->eof) {
+         if (*q >= '0' && *q <= '7')
+            n = n*8 + (*q - '0');
+         else
+            break;
+         ++q;
+      }
+      if (q != lexer->eof && (*q == '8' || *q=='9'))
+         return stb__clex_token(lexer, CLEX_parse_error, p, q);
+      lexer->int_number = n;
+      #endif
+      return stb__clex_parse_suffixes(lexer, CLEX_intlit, p,q, STB_C_LEX_OCTAL_SUFFIXES);
+   }
+   #endif // STB__clex_octal_ints
+
+   #ifdef STB__clex_decimal_ints
+   {
+      char *q = p;
+      #if defined(STB__clex_exact_numbers)
+      lexer->int_number = stb__clex_parse_int(p, lexer->eof, 10, &q);
+      #elif defined(STB__CLEX_use_stdlib)
+      lexer->int_number = strtol((char *) p, (char **) &q, 10);
+      #else
+      stb__clex_int n=0;
+      while (q != lexer->eof) {
+         if (*q >= '0' && *q <= '9')
+            n = n*10 + (*q - '0');
+         else
+            break;
+         ++q;
+      }
+      lexer->int_number = n;
+      #endif
+      return stb__clex_parse_suffixes(lexer, CLEX_intlit, p,q, STB_C_LEX_OCTAL_SUFFIXES);
+   }
+   #endif // STB__clex_decimal_ints
+   return stb__clex_token(lexer, *p, p, p);
+}
+
+#ifdef STB__clex_first_char_table
+// What the first character of a token settles: an identifier, a number, a string,
+// a character that is its own token in every configuration (no case in the switch
+// and not '\0'), or nothing, so the switch decides. The table is built by the
+// preprocessor from the same tests the switch makes, one STB__CLEX_FIRST(c) per byte.
+enum
+{
+   STB__CLEX_FIRST_switch,
+   STB__CLEX_FIRST_ident,
+   STB__CLEX_FIRST_number,
+   STB__CLEX_FIRST_string,
+   STB__CLEX_FIRST_single,
+};
+
+#define STB__CLEX_FIRST(c)                                                                  \
+   (  ((c) >= 'a' && (c) <= 'z') || ((c) >= 'A' && (c) <= 'Z') || (c) == '_' || (c) >= 128   \
+      STB_C_LEX_DOLLAR_IDENTIFIER( || (c) == '$' )                   ? STB__CLEX_FIRST_ident  \
+    : (c) >= '0' && (c) <= '9'                                       ? STB__CLEX_FIRST_number \
+    : (c) == '"'                                                     ? STB__CLEX_FIRST_string \
+    : (c) == 0   || (c) == '\'' || (c) == '+' || (c) == '-' || (c) == '&' || (c) == '|'       \
+      || (c) == '=' || (c) == '!' || (c) == '^' || (c) == '%' || (c) == '*' || (c) == '/'    \
+      || (c) == '<' || (c) == '>'                                    ? STB__CLEX_FIRST_switch \
+    : STB__CLEX_FIRST_single)
+#define STB__CLEX_FIRST4(c)   STB__CLEX_FIRST(c), STB__CLEX_FIRST((c)+1), STB__CLEX_FIRST((c)+2), STB__CLEX_FIRST((c)+3)
+#define STB__CLEX_FIRST16(c)  STB__CLEX_FIRST4(c), STB__CLEX_FIRST4((c)+4), STB__CLEX_FIRST4((c)+8), STB__CLEX_FIRST4((c)+12)
+#define STB__CLEX_FIRST64(c)  STB__CLEX_FIRST16(c), STB__CLEX_FIRST16((c)+16), STB__CLEX_FIRST16((c)+32), STB__CLEX_FIRST16((c)+48)
+
+static const unsigned char stb__clex_first_char[256] =
+{
+   STB__CLEX_FIRST64(0), STB__CLEX_FIRST64(64), STB__CLEX_FIRST64(128), STB__CLEX_FIRST64(192)
+};
+
+static int stb__clex_lex_switch(stb_lexer *lexer, char *p);
+
+// lex the token that starts at p, past any whitespace and comments
+static int stb__clex_lex_token(stb_lexer *lexer, char *p)
+{
+   switch (stb__clex_first_char[(unsigned char) *p]) {
+      case STB__CLEX_FIRST_ident:  return stb__clex_lex_ident(lexer, p);
+      case STB__CLEX_FIRST_number: return stb__clex_lex_number(lexer, p);
+      case STB__CLEX_FIRST_string: STB_C_LEX_C_DQ_STRINGS(return stb__clex_parse_string(lexer, p, CLEX_dqstring);)
+                                   return stb__clex_token(lexer, *p, p, p);
+      case STB__CLEX_FIRST_single: return stb__clex_token(lexer, *p, p, p);
+      default:                     return stb__clex_lex_switch(lexer, p);
+   }
+}
+#else
+#define stb__clex_lex_switch  stb__clex_lex_token
+#endif
+
+// lex the token that starts at p, past any whitespace and comments
+static int stb__clex_lex_switch(stb_lexer *lexer, char *p)
+{
    switch (*p) {
       default:
          if (   (*p >= 'a' && *p <= 'z')
              || (*p >= 'A' && *p <= 'Z')
              || *p == '_' || (unsigned char) *p >= 128    // >= 128 is UTF8 char
              STB_C_LEX_DOLLAR_IDENTIFIER( || *p == '$' ) )
-         {
-            int n = 0;
-            lexer->string = lexer->string_storage;
-            do {
-               if (n+1 >= lexer->string_storage_len)
-                  return stb__clex_token(lexer, CLEX_parse_error, p, p+n);
-               lexer->string[n] = p[n];
-               ++n;
-            } while (
-                  (p[n] >= 'a' && p[n] <= 'z')
-               || (p[n] >= 'A' && p[n] <= 'Z')
-               || (p[n] >= '0' && p[n] <= '9') // allow digits in middle of identifier
-               || p[n] == '_' || (unsigned char) p[n] >= 128
-                STB_C_LEX_DOLLAR_IDENTIFIER( || p[n] == '$' )
-            );
-            lexer->string[n] = 0;
-            lexer->string_len = n;
-            return stb__clex_token(lexer, CLEX_id, p, p+n-1);
-         }
+            return stb__clex_lex_ident(lexer, p);
 
          // check for EOF
          STB_C_LEX_0_IS_EOF(
@@ -672,131 +2288,342 @@ int stb_c_lexer_get_token(stb_lexer *lexer)
                return stb__clex_token(lexer, CLEX_parse_error, start,start);
             if (p == lexer->eof || *p != '\'')
                return stb__clex_token(lexer, CLEX_parse_error, start,p);
-            return stb__clex_token(lexer, CLEX_charlit, start, p+1);
+            return stb__clex_token(lexer, CLEX_charlit, start, p);
          })
+         #ifdef STB__clex_char_errors
+         {
+            // the extent a char literal would have, errors included, but never past eof
+            char *start = p;
+            if (p+1 == lexer->eof || (p[1] == '\\' && p+2 == lexer->eof))
+               return stb__clex_token(lexer, CLEX_parse_error, start, lexer->eof-1);
+            if (stb__clex_parse_char(p+1, &p) < 0)
+               return stb__clex_token(lexer, CLEX_parse_error, start,start);
+            return stb__clex_token(lexer, CLEX_parse_error, start, p == lexer->eof ? p-1 : p);
+         }
+         #endif
          goto single_char;
 
-      case '0':
-         #if defined(STB__clex_hex_ints) || defined(STB__clex_hex_floats)
-            if (p+1 != lexer->eof) {
-               if (p[1] == 'x' || p[1] == 'X') {
-                  char *q;
-
-                  #ifdef STB__clex_hex_floats
-                  for (q=p+2;
-                       q != lexer->eof && ((*q >= '0' && *q <= '9') || (*q >= 'a' && *q <= 'f') || (*q >= 'A' && *q <= 'F'));
-                       ++q);
-                  if (q != lexer->eof) {
-                     if (*q == '.' STB_C_LEX_FLOAT_NO_DECIMAL(|| *q == 'p' || *q == 'P')) {
-                        #ifdef STB__CLEX_use_stdlib
-                        lexer->real_number = strtod((char *) p, (char**) &q);
-                        #else
-                        lexer->real_number = stb__clex_parse_float(p, &q);
-                        #endif
-
-                        if (p == q)
-                           return stb__clex_token(lexer, CLEX_parse_error, p,q);
-                        return stb__clex_parse_suffixes(lexer, CLEX_floatlit, p,q, STB_C_LEX_FLOAT_SUFFIXES);
-
-                     }
-                  }
-                  #endif   // STB__CLEX_hex_floats
+      case '0': case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+         return stb__clex_lex_number(lexer, p);
+   }
+}
 
-                  #ifdef STB__clex_hex_ints
-                  #ifdef STB__CLEX_use_stdlib
-                  lexer->int_number = strtol((char *) p, (char **) &q, 16);
-                  #else
-                  {
-                     stb__clex_int n=0;
-                     for (q=p+2; q != lexer->eof; ++q) {
-                        if (*q >= '0' && *q <= '9')
-                           n = n*16 + (*q - '0');
-                        else if (*q >= 'a' && *q <= 'f')
-                           n = n*16 + (*q - 'a') + 10;
-                        else if (*q >= 'A' && *q <= 'F')
-                           n = n*16 + (*q - 'A') + 10;
-                        else
-                           break;
-                     }
-                     lexer->int_number = n;
-                  }
-                  #endif
-                  if (q == p+2)
-                     return stb__clex_token(lexer, CLEX_parse_error, p-2,p-1);
-                  return stb__clex_parse_suffixes(lexer, CLEX_intlit, p,q, STB_C_LEX_HEX_SUFFIXES);
-                  #endif
-               }
-            }
-         #endif // defined(STB__clex_hex_ints) || defined(STB__clex_hex_floats)
-         // can't test for octal because we might parse '0.0' as float or as '0' '.' '0',
-         // so have to do float first
+// Streaming: the skip phase runs here, as a state machine that can stop at
+// any byte; a token is lexed in place by stb__clex_lex_token when it ends
+// at least one byte before the chunk does (so the longest match is settled),
+// otherwise its bytes so far move into the carry buffer and it is lexed
+// there once enough of the next chunk has been appended.
+enum
+{
+   STB__CLEX_STREAM_normal,
+   STB__CLEX_STREAM_slash,         // a '/' ended the chunk, comment or not
+   STB__CLEX_STREAM_line,          // in a // comment or a discarded # line
+   STB__CLEX_STREAM_block,         // in a /* comment */
+   STB__CLEX_STREAM_block_star,    // ... and the chunk ended with '*'
+};
 
-         /* FALL THROUGH */
-      case '1': case '2': case '3': case '4': case '5': case '6': case '7': case '8': case '9':
+// carry_capacity minus this is the longest token; the slack keeps the lookahead
+// of stb__clex_parse_char inside the buffer
+#define STB__CLEX_STREAM_SLACK  4
 
-         #ifdef STB__clex_decimal_floats
-         {
-            char *q = p;
-            while (q != lexer->eof && (*q >= '0' && *q <= '9'))
-               ++q;
-            if (q != lexer->eof) {
-               if (*q == '.' STB_C_LEX_FLOAT_NO_DECIMAL(|| *q == 'e' || *q == 'E')) {
-                  #ifdef STB__CLEX_use_stdlib
-                  lexer->real_number = strtod((char *) p, (char**) &q);
-                  #else
-                  lexer->real_number = stb__clex_parse_float(p, &q);
-                  #endif
+// API function
+void stb_c_lexer_stream_init(stb_lex_stream *stream, char *carry_buffer, int carry_length, char *string_store, int store_length)
+{
+   stb_c_lexer_init(&stream->lexer, 0, 0, string_store, store_length);
+   stream->chunk = stream->chunk_end = stream->chunk_base = 0;
+   stream->chunk_offset = 0;
+   stream->carry = carry_buffer;
+   stream->carry_offset = 0;
+   stream->carry_len = 0;
+   stream->carry_skip = 0;
+   stream->carry_capacity = carry_length;
+   stream->string_store = string_store;
+   stream->store_length = store_length;
+   stream->state = STB__CLEX_STREAM_normal;
+   stream->finished = 0;
+}
 
-                  return stb__clex_parse_suffixes(lexer, CLEX_floatlit, p,q, STB_C_LEX_FLOAT_SUFFIXES);
+// API function
+void stb_c_lexer_stream_feed(stb_lex_stream *stream, const char *chunk, const char *chunk_end)
+{
+   stb_lex_lines *lines = stream->lexer.lines;
+   stream->chunk_offset += (int) (stream->chunk_end - stream->chunk_base);
+   stream->chunk = stream->chunk_base = (char *) chunk;
+   stream->chunk_end = (char *) chunk_end;
+   if (lines && lines->count) {
+      // the chunk may be gone by the time a location is asked for, index it now
+      lines->chunk = lines->end;
+      stb__clex_scan_lines(lines, &lines->end, chunk, stream->chunk_offset + (int) (chunk_end - chunk));
+   }
+}
 
-               }
-            }
+// the carry buffer starts at p in the chunk, or the char before if behind
+static void stb__clex_stream_carry_starts(stb_lex_stream *stream, char *p, int behind)
+{
+   stb_lex_lines *lines = stream->lexer.lines;
+   stream->carry_offset = stream->chunk_offset + (int) (p - stream->chunk_base) - behind;
+   if (lines && lines->count) {
+      // a walk in the carry buffer starts here; behind is a '/', which doesn't change the line
+      lines->carry = stb__clex_line_at(lines, stream->carry_offset + behind, lines->chunk, stream->chunk_base, stream->chunk_end);
+      lines->carry.offset = stream->carry_offset;
+      lines->carry.pending = 0;
+   }
+}
+
+// API function
+void stb_c_lexer_stream_get_location(const stb_lex_stream *stream, const char *where, stb_lex_location *loc)
+{
+   stb_lex_lines *lines = stream->lexer.lines;
+   stb_lex_line_cursor c;
+   int offset;
+   if (!lines || !lines->count) {
+      loc->line_number = loc->line_offset = 0;
+      return;
+   }
+   if (where >= stream->carry && where < stream->carry + stream->carry_capacity) {
+      offset = stream->carry_offset + (int) (where - stream->carry);
+      c = stb__clex_line_at(lines, offset, lines->carry, stream->carry, stream->carry + stream->carry_capacity);
+   } else {
+      offset = stream->chunk_offset + (int) (where - stream->chunk_base);
+      c = stb__clex_line_at(lines, offset, lines->chunk, stream->chunk_base, stream->chunk_end);
+   }
+   loc->line_number = c.line + 1;
+   loc->line_offset = offset - c.line_start;
+}
+
+// API function
+void stb_c_lexer_stream_finish(stb_lex_stream *stream)
+{
+   stream->finished = 1;
+}
+
+// a number can still grow after it looks complete ("1e" + "5", "0x" + "1F"),
+// and character literals read ahead without checking eof, so they are only
+// lexed in place if something stops them before the end of the chunk
+static int stb__clex_stream_in_place(char *p, char *end)
+{
+   if (*p >= '0' && *p <= '9') {
+      while (p != end && (stb__clex_isident(*p) || *p == '.' || *p == '+' || *p == '-'))
+         ++p;
+      return p != end;
+   }
+   if (*p == '\'')
+      return end - p > 3;
+   return 1;
+}
+
+// lex the token at p; it is complete if it is the last one or it stops before end.
+// In the carry buffer whatever a token left behind may start with whitespace,
+// so that goes through the skipping of stb_c_lexer_get_token.
+static int stb__clex_stream_lex(stb_lex_stream *stream, char *p, char *end, int last, int skip)
+{
+   stb_lexer *lexer = &stream->lexer;
+   if (!last && ((*p >= '0' && *p <= '9') || *p == '\'') && !stb__clex_stream_in_place(p, end))
+      return 0;
+   lexer->parse_point = p;
+   lexer->eof = end;
+   #ifdef STB__clex_zero_copy
+   // decoded strings only need to last until the next token
+   lexer->string_storage = stream->string_store;
+   lexer->string_storage_len = stream->store_length;
+   #endif
+   if (!skip)
+      stb__clex_lex_token(lexer, p);
+   else if (!stb_c_lexer_get_token(lexer))
+      return last;
+   return last || lexer->where_lastchar < end-1;
+}
+
+// lex the token in the carry buffer, appending the next chunk a bit at a time
+static int stb__clex_stream_carry(stb_lex_stream *stream)
+{
+   stb_lexer *lexer = &stream->lexer;
+   int step = 32;
+
+   if (stream->carry_skip) {
+      // the last token left this behind, it's been returned so it can move now
+      if (lexer->lines && lexer->lines->count)
+         stb__clex_scan_lines(0, &lexer->lines->carry, stream->carry, stream->carry_offset + stream->carry_skip);
+      memmove(stream->carry, stream->carry + stream->carry_skip, stream->carry_len);
+      stream->carry_offset += stream->carry_skip;
+      stream->carry_skip = 0;
+   }
+
+   for (;;) {
+      int old_len = stream->carry_len;
+      int room = stream->carry_capacity - STB__CLEX_STREAM_SLACK - old_len;
+      int n = (int) (stream->chunk_end - stream->chunk);
+      int last;
+      if (n > step) n = step;
+      if (n > room) n = room;
+      memcpy(stream->carry + old_len, stream->chunk, n);
+      stream->carry_len += n;
+      memset(stream->carry + stream->carry_len, 0, STB__CLEX_STREAM_SLACK);
+
+      last = stream->finished && stream->chunk + n == stream->chunk_end;
+      if (stb__clex_stream_lex(stream, stream->carry, stream->carry + stream->carry_len, last, 1)) {
+         int used;
+         if (lexer->token == CLEX_eof) {
+            stream->chunk += n;
+            stream->carry_len = 0;
+            return 0;
+         }
+         used = (int) (lexer->parse_point - stream->carry);
+         if (used >= old_len) {
+            // the token is complete, resume in place after it
+            stream->chunk += used - old_len;
+            stream->carry_len = 0;
+         } else {
+            // it ended inside what was carried already, e.g. the 'f' of "1.0f";
+            // the rest stays in the carry buffer for the next token
+            stream->carry_skip = used;
+            stream->carry_len = old_len - used;
          }
-         #endif // STB__clex_decimal_floats
+         return 1;
+      }
+      stream->chunk += n;
+      if (stream->chunk == stream->chunk_end) {
+         lexer->token = CLEX_need_more;
+         return 0;
+      }
+      if (n == room) {
+         stream->carry_len = 0;
+         return stb__clex_token(lexer, CLEX_parse_error, stream->carry, stream->carry + old_len + n - 1);
+      }
+      step *= 2;
+   }
+}
 
-         #ifdef STB__clex_octal_ints
-         if (p[0] == '0') {
-            char *q = p;
-            #ifdef STB__CLEX_use_stdlib
-            lexer->int_number = strtol((char *) p, (char **) &q, 8);
-            #else
-            stb__clex_int n=0;
-            while (q != lexer->eof) {
-               if (*q >= '0' && *q <= '7')
-                  n = n*8 + (*q - '0');
-               else
-                  break;
-               ++q;
+static int stb__clex_stream_carry_from(stb_lex_stream *stream, char *p, char *end)
+{
+   int n = (int) (end - p);
+   if (n > stream->carry_capacity - STB__CLEX_STREAM_SLACK) {
+      stream->chunk = end;
+      return stb__clex_token(&stream->lexer, CLEX_parse_error, p, end-1);
+   }
+   stb__clex_stream_carry_starts(stream, p, 0);
+   memcpy(stream->carry, p, n);
+   stream->carry_len = n;
+   stream->chunk = end;
+   stream->lexer.token = CLEX_need_more;
+   return 0;
+}
+
+// API function
+int stb_c_lexer_stream_get_token(stb_lex_stream *stream)
+{
+   char *p = stream->chunk;
+   char *end = stream->chunk_end;
+
+   if (stream->carry_len > 0) {
+      if (p == end && !stream->finished) {
+         stream->lexer.token = CLEX_need_more;
+         return 0;
+      }
+      return stb__clex_stream_carry(stream);
+   }
+
+   while (p != end) {
+      switch (stream->state) {
+         case STB__CLEX_STREAM_line:
+            p = stb__clex_find_eol(p, end);
+            if (p != end)
+               stream->state = STB__CLEX_STREAM_normal;
+            break;
+
+         case STB__CLEX_STREAM_block_star:
+            stream->state = STB__CLEX_STREAM_block;
+            if (*p == '/') {
+               ++p;
+               stream->state = STB__CLEX_STREAM_normal;
             }
-            if (q != lexer->eof && (*q == '8' || *q=='9'))
-               return stb__clex_token(lexer, CLEX_parse_error, p, q);
-            lexer->int_number = n;
-            #endif
-            return stb__clex_parse_suffixes(lexer, CLEX_intlit, p,q, STB_C_LEX_OCTAL_SUFFIXES);
-         }
-         #endif // STB__clex_octal_ints
+            break;
 
-         #ifdef STB__clex_decimal_ints
-         {
-            char *q = p;
-            #ifdef STB__CLEX_use_stdlib
-            lexer->int_number = strtol((char *) p, (char **) &q, 10);
+         case STB__CLEX_STREAM_block:
+            p = stb__clex_find_comment_end(p, end);
+            if (p != end) {
+               p += 2;
+               stream->state = STB__CLEX_STREAM_normal;
+            } else if (p[-1] == '*') {
+               // a '/' starting the next chunk closes it
+               stream->state = STB__CLEX_STREAM_block_star;
+            }
+            break;
+
+         case STB__CLEX_STREAM_slash:
+            stream->state = STB__CLEX_STREAM_normal;
+            STB_C_LEX_CPP_COMMENTS(if (*p == '/') { ++p; stream->state = STB__CLEX_STREAM_line;  break; })
+            STB_C_LEX_C_COMMENTS(  if (*p == '*') { ++p; stream->state = STB__CLEX_STREAM_block; break; })
+            stb__clex_stream_carry_starts(stream, p, 1);
+            stream->carry[0] = '/';
+            stream->carry_len = 1;
+            stream->chunk = p;
+            return stb__clex_stream_carry(stream);
+
+         default:
+            #ifdef STB_C_LEX_ISWHITE
+            while (p != end) {
+               int n = STB_C_LEX_ISWHITE(p);
+               if (n == 0) break;
+               p += n;
+            }
             #else
-            stb__clex_int n=0;
-            while (q != lexer->eof) {
-               if (*q >= '0' && *q <= '9')
-                  n = n*10 + (*q - '0');
-               else
-                  break;
-               ++q;
+            p = stb__clex_skip_white(p, end);
+            #endif
+            if (p == end)
+               break;
+
+            if (*p == '/') {
+               if (p+1 == end) {
+                  if (!stream->finished) {
+                     ++p;
+                     stream->state = STB__CLEX_STREAM_slash;
+                     break;
+                  }
+               } else {
+                  STB_C_LEX_CPP_COMMENTS(if (p[1] == '/') { p += 2; stream->state = STB__CLEX_STREAM_line;  break; })
+                  STB_C_LEX_C_COMMENTS(  if (p[1] == '*') { p += 2; stream->state = STB__CLEX_STREAM_block; break; })
+               }
+            }
+
+            #ifdef STB__clex_discard_preprocessor
+            if (*p == '#') {
+               ++p;
+               stream->state = STB__CLEX_STREAM_line;
+               break;
             }
-            lexer->int_number = n;
             #endif
-            return stb__clex_parse_suffixes(lexer, CLEX_intlit, p,q, STB_C_LEX_OCTAL_SUFFIXES);
-         }
-         #endif // STB__clex_decimal_ints
-         goto single_char;
+
+            if (stb__clex_stream_lex(stream, p, end, stream->finished, 0)) {
+               stream->chunk = stream->lexer.parse_point;
+               return 1;
+            }
+            return stb__clex_stream_carry_from(stream, p, end);
+      }
+   }
+
+   stream->chunk = end;
+   if (!stream->finished) {
+      stream->lexer.token = CLEX_need_more;
+      return 0;
+   }
+
+   switch (stream->state) {
+      case STB__CLEX_STREAM_slash:
+         // the input ended with a lone '/'
+         stream->state = STB__CLEX_STREAM_normal;
+         stb__clex_stream_carry_starts(stream, end, 1);
+         stream->carry[0] = '/';
+         stream->carry_len = 1;
+         return stb__clex_stream_carry(stream);
+      case STB__CLEX_STREAM_block:
+      case STB__CLEX_STREAM_block_star:
+         stream->state = STB__CLEX_STREAM_normal;
+         stream->lexer.where_firstchar = stream->lexer.where_lastchar = 0;
+         stream->lexer.token = CLEX_parse_error;
+         return 1;
    }
+   return stb__clex_eof(&stream->lexer);
 }
 #endif // STB_C_LEXER_IMPLEMENTATION
 
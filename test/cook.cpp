@@ -0,0 +1,240 @@
+/* Checks cook.hpp against the C side of cook.h it shares its layout with,
+ * and the string builder of cook.h that cook::vec<char> stands in for.
+ *
+ * Build and run it with `./nob test-cook`. It is built with the address and
+ * undefined behaviour sanitizers, so a container touching storage it just
+ * moved away from fails here even when the values happen to survive.
+ */
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+#define COOK_IMPLEMENTATION
+#include "../cook.hpp"
+
+static int failures = 0;
+
+#define CHECK(cond)                                                                       \
+    do {                                                                                  \
+        if (!(cond)) {                                                                    \
+            std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #cond); \
+            failures++;                                                                   \
+        }                                                                                 \
+    } while (0)
+
+/* a cook_vec_* vector handed to C++ and back */
+static void test_vec_adopt_release(void)
+{
+    int *items = NULL;
+    for (int i = 0; i < 100; i++) cook_vec_push(items, i);
+
+    cook::vec<int> v = cook::vec<int>::adopt(items);
+    CHECK(v.size() == 100);
+    CHECK(v.capacity() == cook_vec_capacity(items));
+    for (int i = 100; i < 1000; i++) v.push_back(i);
+    CHECK(v.size() == 1000);
+
+    items = v.release();
+    CHECK(v.data() == nullptr && v.size() == 0);
+    CHECK(cook_vec_size(items) == 1000);
+    cook_vec_push(items, 1000);
+    bool ok = true;
+    for (int i = 0; i <= 1000; i++) ok = ok && items[i] == i;
+    CHECK(ok);
+    cook_vec_free(items);
+}
+
+/* formatted appends go into the free tail, or reserve and format again when it is too short */
+static void test_sb_append(void)
+{
+    Cook_String_Builder sb = NULL;
+    std::string expected;
+
+    cook_sb_append(&sb, "%d-%s", 42, "ab"); /* no buffer yet: measure, reserve, format */
+    expected += "42-ab";
+    CHECK(cook_vec_size(sb) == expected.size());
+    CHECK(cook_vec_capacity(sb) == cook_vec_grow_capacity(0, expected.size() + 1));
+
+    char *items = sb;
+    cook_sb_append(&sb, "[%03d]", 7); /* fits the tail, no reallocation */
+    expected += "[007]";
+    CHECK(sb == items && cook_vec_size(sb) == expected.size());
+
+    std::size_t avail = cook_vec_capacity(sb) - cook_vec_size(sb);
+    std::string exact(avail, 'x'); /* fills the tail but its NUL, so it retries */
+    cook_sb_append(&sb, "%s", exact.c_str());
+    expected += exact;
+
+    std::string big(5000, 'y');
+    cook_sb_append(&sb, "<%s>", big.c_str());
+    expected += "<" + big + ">";
+    cook_sb_append(&sb, "%s", "");
+
+    CHECK(cook_vec_size(sb) == expected.size());
+    CHECK(std::memcmp(sb, expected.data(), expected.size()) == 0);
+    cook_sb_free(&sb);
+}
+
+/* reserve grows by cook_vec_grow_capacity() like every other vector, and only when it has to */
+static void test_sb_reserve(void)
+{
+    Cook_String_Builder sb = NULL;
+
+    cook_sb_reserve(&sb, 10);
+    CHECK(cook_vec_size(sb) == 0 && cook_vec_capacity(sb) == cook_vec_grow_capacity(0, 10));
+    cook_sb_append_parts(&sb, "0123456789", 10);
+
+    std::size_t capacity = cook_vec_capacity(sb);
+    cook_sb_reserve(&sb, capacity - cook_vec_size(sb));
+    CHECK(cook_vec_capacity(sb) == capacity);
+    cook_sb_reserve(&sb, capacity - cook_vec_size(sb) + 1);
+    CHECK(cook_vec_capacity(sb) == cook_vec_grow_capacity(capacity, capacity + 1));
+    cook_sb_reserve(&sb, 1000);
+    CHECK(cook_vec_capacity(sb) >= 1010);
+    CHECK(cook_vec_size(sb) == 10 && std::memcmp(sb, "0123456789", 10) == 0);
+
+    cook_sb_append_sv(&sb, cook_sv_from_cstr("abc"));
+    CHECK(cook_vec_size(sb) == 13 && std::memcmp(sb + 10, "abc", 3) == 0);
+    cook_sb_free(&sb);
+}
+
+/* a small_vec seen as the Cook_Small_Vector it mirrors, inline and spilled */
+typedef Cook_Small_Vector(int, 4) C_Ints;
+
+static void test_small_vec_as(void)
+{
+    cook::small_vec<int, 4> sv;
+    C_Ints *c = sv.as<C_Ints>();
+
+    sv.push_back(0);
+    sv.push_back(1);
+    cook_svec_push(c, 2);
+    CHECK(cook_svec_inline(c) && sv.is_inline());
+    CHECK(cook_svec_size(c) == 3 && sv.size() == 3);
+    CHECK(cook_svec_capacity(c) == 4 && sv.capacity() == 4);
+    CHECK(cook_svec_data(c) == sv.data());
+
+    for (int i = 3; i < 20; i++) {
+        if (i % 2) cook_svec_push(c, i);
+        else sv.push_back(i);
+    }
+    CHECK(!cook_svec_inline(c) && !sv.is_inline());
+    CHECK(cook_svec_size(c) == 20 && sv.size() == 20);
+    CHECK(cook_svec_capacity(c) == sv.capacity());
+    CHECK(cook_svec_data(c) == sv.data());
+    bool ok = true;
+    for (int i = 0; i < 20; i++) ok = ok && sv.data()[i] == i;
+    CHECK(ok);
+
+    sv.clear();
+    sv.push_back(42);
+    sv.shrink_to_fit();
+    CHECK(cook_svec_inline(c) && cook_svec_data(c)[0] == 42);
+}
+
+/* an arena vector grows in place while it is the last allocation, and is copied once it is not */
+static void test_vec_arena_growth(void)
+{
+    cook::arena a(64*1024);
+    cook::vec<int> v(a);
+
+    for (int i = 0; i < 16; i++) v.push_back(i);
+    int *first = v.data();
+    std::size_t used = a.used();
+    for (int i = 16; i < 100; i++) v.push_back(i);
+    CHECK(v.data() == first);
+    CHECK(a.used() == used + (v.capacity() - 16)*sizeof(int));
+
+    int *other = NULL;
+    cook_vec_push_arena(a.c(), other, -1);
+    std::size_t capacity = v.capacity();
+    while (v.size() < capacity) v.push_back((int)v.size());
+    v.push_back((int)v.size());
+    CHECK(v.data() != first);
+    CHECK(v.size() == capacity + 1 && v.capacity() > capacity);
+    bool ok = true;
+    for (std::size_t i = 0; i < v.size(); i++) ok = ok && v.data()[i] == (int)i;
+    CHECK(ok);
+    CHECK(other[0] == -1 && cook_vec_size(other) == 1);
+
+    a.reset();
+    CHECK(a.used() == 0);
+}
+
+/* random inserts and erases over a small key range, so erase keeps shifting runs back */
+static void test_hash_map(void)
+{
+    cook::hash_map<std::uint32_t, std::uint32_t> map;
+    std::map<std::uint32_t, std::uint32_t> reference;
+    std::uint32_t state = 0x9e3779b9u;
+
+    for (int i = 0; i < 200000; i++) {
+        state = state*1664525u + 1013904223u;
+        std::uint32_t key = (state >> 8) % 512;
+        std::uint32_t value = state >> 16;
+        if ((state & 3) == 0) {
+            CHECK(map.erase(key) == (reference.erase(key) == 1));
+        } else {
+            CHECK(map.insert(key, value) == reference.insert_or_assign(key, value).second);
+        }
+    }
+
+    CHECK(map.size() == reference.size());
+    std::size_t missing = 0;
+    for (std::uint32_t key = 0; key < 512; key++) {
+        const std::uint32_t *value = map.find(key);
+        auto it = reference.find(key);
+        if (it == reference.end() ? value != nullptr : value == nullptr || *value != it->second) missing++;
+    }
+    CHECK(missing == 0);
+
+    std::size_t visited = 0;
+    map.for_each([&](std::uint32_t key, std::uint32_t value) {
+        visited++;
+        CHECK(reference.at(key) == value);
+    });
+    CHECK(visited == reference.size());
+
+    map.clear();
+    CHECK(map.size() == 0 && !map.contains(0));
+}
+
+/* emplace_back() of one of the container's own items, right when it has to grow */
+static void test_emplace_aliasing(void)
+{
+    cook::vec<long> v;
+    v.push_back(7);
+    while (v.size() < v.capacity()) v.push_back(v.back() + 1);
+    long last = v.back();
+    v.emplace_back(v.back());
+    CHECK(v.back() == last && v.size() == 17);
+
+    cook::small_vec<long, 4> sv;
+    for (long i = 0; i < 4; i++) sv.push_back(i);
+    sv.emplace_back(sv.back());
+    CHECK(!sv.is_inline() && sv.back() == 3);
+    while (sv.size() < sv.capacity()) sv.push_back(sv.back() + 1);
+    last = sv.back();
+    sv.emplace_back(sv.back());
+    CHECK(sv.back() == last);
+}
+
+int main(void)
+{
+    test_sb_append();
+    test_sb_reserve();
+    test_vec_adopt_release();
+    test_small_vec_as();
+    test_vec_arena_growth();
+    test_hash_map();
+    test_emplace_aliasing();
+
+    if (failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", failures);
+        return 1;
+    }
+    std::printf("cook.hpp: all checks passed\n");
+    return 0;
+}